@@ -1,7 +1,70 @@
 // This is a personal academic project. Dear PVS-Studio, please check it.
 // PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifdef __linux__
+#define _GNU_SOURCE // for copy_file_range
+#endif
+
 #include "c_string.h"
 
+#include <unistd.h>
+#include <limits.h> // for INT_MAX and SSIZE_MAX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static size_t length_cstr(const char * str);
+static void hash_multiply(uint64_t* a, uint64_t* b);
+static uint64_t hash_mix(uint64_t a, uint64_t b);
+static uint64_t hash_read8(const unsigned char* p);
+static uint64_t hash_read4(const unsigned char* p);
+
+// default secret of wyhash, odd numbers with 32 bits set
+static const uint64_t hash_secret[4] = {
+        0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+static int write_all_fd(int fd, const char* buf, size_t size);
+static int transfer_file_stdio(FILE* from, int fd, size_t count, size_t* transferred);
+static int stdio_buffer_empty(FILE* file);
+static int stdio_may_have_read_ahead(FILE* file);
+static int unshare(my_str_t* str);
+static void release_shared(my_str_t* str);
+static void shrink(my_str_t* str);
+static char* alloc_buffer(size_t capacity);
+static void free_buffer(char* data, size_t capacity);
+static size_t huge_size(size_t capacity);
+static char* map_huge(size_t bytes);
+#ifdef __linux__
+static char* remap_huge(char* data, size_t old_bytes, size_t bytes);
+#endif
+static int move_buffer(my_str_t* str, size_t capacity);
+static size_t find_byte(const char* data, size_t from, size_t size, char c);
+#ifdef __SSE2__
+static unsigned lowest_bit(unsigned mask);
+#endif
+
+// policy of automatic shrinking, off by default
+static my_str_shrink_policy_t shrink_policy = {0, 0, 0};
+
+// bigger buffers with the padding rounded to huge pages do not fit in size_t
+#define MAX_CAPACITY (SIZE_MAX - 1 - MY_STR_PADDING - 2 * MY_STR_HUGE_PAGE)
+
+// reference counts of shared buffers are atomic, strings sharing a buffer may be in different threads
+#if defined(__GNUC__) || defined(__clang__)
+#define REFS_ADD(refs) __atomic_add_fetch(&(refs), 1, __ATOMIC_RELAXED)
+#define REFS_SUB(refs) __atomic_sub_fetch(&(refs), 1, __ATOMIC_ACQ_REL)
+#define REFS_GET(refs) __atomic_load_n(&(refs), __ATOMIC_ACQUIRE)
+#else
+#define REFS_ADD(refs) (++(refs))
+#define REFS_SUB(refs) (--(refs))
+#define REFS_GET(refs) (refs)
+#endif
+
 /*
  * Creates empty dynamic string (my_str_t)
  * !important! user should always use my_str_create before using ANY other function
@@ -16,15 +79,16 @@ int my_str_create(my_str_t* str, size_t buf_size) {
     if (!str)
         return NULL_PTR_ERR;
 
-    // overflow check
-    buf_size = (buf_size == SIZE_MAX) ? buf_size : buf_size + 1;
-
-    str->data = (char *) calloc(buf_size, sizeof(char));
+    // buffer is not zeroed, only bytes up to size are ever used
+    str->data = alloc_buffer(buf_size);
     if (!str->data)
         return MEMORY_ALLOCATION_ERR;
+    str->data[0] = '\0';
 
     str->size_m = 0;
-    str->capacity_m = buf_size-1;
+    str->capacity_m = buf_size;
+    str->hash_m = 0;
+    str->shared = NULL;
 
     return 0;
 }
@@ -38,14 +102,16 @@ int my_str_free(my_str_t* str) {
     if (!str)
         return 0;
 
-    str->size_m = 0;
-    str->capacity_m = 0;
-
-    if (!str->data)
-        return 0;
+    // shared buffer is freed only by the last string that uses it
+    if (str->shared)
+        release_shared(str);
+    else
+        free_buffer(str->data, str->capacity_m);
 
-    free(str->data);
     str->data = NULL;
+    str->size_m = 0;
+    str->capacity_m = 0;
+    str->hash_m = 0;
 
     return 0;
 }
@@ -69,7 +135,8 @@ int my_str_from_cstr(my_str_t* str, const char* cstr, size_t buf_size) {
     if (buf_size < length && buf_size != 0)
         return BUFF_SIZE_ERR;
 
-    int reserve, err;
+    int reserve, err = unshare(str);
+    if (err != 0) return err;
     // determines whether buffer should be increased, as well as its size
     reserve = (buf_size == 0 || str->capacity_m < length) ? 1 : 0;
     buf_size = (!buf_size) ? length : buf_size;
@@ -85,6 +152,7 @@ int my_str_from_cstr(my_str_t* str, const char* cstr, size_t buf_size) {
 
     memcpy(str->data, cstr, length);
     str->size_m = length;
+    str->hash_m = 0;
 
     return 0;
 }
@@ -113,6 +181,35 @@ int my_str_empty(const my_str_t* str) {
     return (!str || !str->size_m) ? 1 : 0;
 }
 
+/*
+ * returns view of the whole content of my_str-string
+ * view is invalidated by any change of the string
+ * if str == NULL than view is empty
+ */
+my_str_view_t my_str_view(const my_str_t* str) {
+    my_str_view_t view = {NULL, 0};
+    if (!str)
+        return view;
+
+    view.data = str->data;
+    view.size_m = str->size_m;
+    return view;
+}
+
+/*
+ * returns view of given c-string (without terminating zero)
+ * if cstr == NULL than view is empty
+ */
+my_str_view_t my_str_view_cstr(const char* cstr) {
+    my_str_view_t view = {NULL, 0};
+    if (!cstr)
+        return view;
+
+    view.data = cstr;
+    view.size_m = length_cstr(cstr);
+    return view;
+}
+
 /*
  * returns symbol on given index in my_str-string
  * return:
@@ -142,7 +239,11 @@ int my_str_putc(my_str_t* str, size_t index, char c) {
     if (index >= str->size_m)
         return RANGE_ERR;
 
+    int err = unshare(str);
+    if (err != 0) return err;
+
     str->data[index] = c;
+    str->hash_m = 0;
 
     return 0;
 }
@@ -157,6 +258,11 @@ const char* my_str_get_cstr(my_str_t* str) {
     if (!str || !str->data)
         return NULL;
 
+    // byte after the content may belong to another string that shares the buffer
+    if (str->shared && str->data + str->size_m != str->shared->data + str->shared->size_m)
+        if (unshare(str) != 0)
+            return NULL;
+
     str->data[str->size_m] = '\0';
     return str->data;
 }
@@ -180,6 +286,7 @@ int my_str_copy(const my_str_t* from,  my_str_t* to, int reserve) {
 
     memcpy(to->data, from->data, from->size_m);
     to->size_m = from->size_m;
+    to->hash_m = from->hash_m;
 
     return 0;
 }
@@ -187,13 +294,26 @@ int my_str_copy(const my_str_t* from,  my_str_t* to, int reserve) {
 /*
  *  clears content of string, does nothing if string is NULL
  *  return:
- *      always 0
+ *      0  if OK
+ *      MEMORY_ALLOCATION_ERR if string shared its buffer and there was an error during
+ *      allocation of own one, string is left empty without buffer then
  */
 int my_str_clear(my_str_t* str) {
     if (!str) return 0;
 
-    memset(str->data, 0, str->capacity_m);
+    // content of shared buffer is not needed, new empty buffer is enough
+    if (str->shared) {
+        release_shared(str);
+        str->size_m = str->capacity_m = 0;
+        str->hash_m = 0;
+        return my_str_create(str, 0);
+    }
+
+    // buffer is kept, so loops that clear and refill string never reallocate
     str->size_m = 0;
+    str->hash_m = 0;
+    if (str->data)
+        memset(str->data, 0, str->capacity_m);
 
     return 0;
 }
@@ -216,7 +336,8 @@ int my_str_insert_c(my_str_t* str, char c, size_t pos) {
 
     size_t i = my_str_size(str);
 
-    int err;
+    int err = unshare(str);
+    if (err != 0) return err;
     // we should increase capacity to have enough space for element to insert
     // as well as an additional space for end-of-string character
     if (str->size_m + 1 > str->capacity_m) {
@@ -231,6 +352,7 @@ int my_str_insert_c(my_str_t* str, char c, size_t pos) {
     for (; i > pos; --i)
         str->data[i] = str->data[i - 1];
     str->data[i] = c;
+    str->hash_m = 0;
 
     return 0;
 }
@@ -269,14 +391,14 @@ int my_str_insert_cstr(my_str_t* str, const char* from, size_t pos){
         return RANGE_ERR;
 
     size_t length_from = length_cstr(from);
-    int err, i;
-    err = my_str_reserve(str, str->capacity_m + length_from);
+    char* spare;
+    int err = my_str_reserve_uninit(str, length_from, &spare);
     if (err != 0) return err;
 
-    for(i = str->size_m - 1; i >= (int)pos; i--)
-        str->data[i + length_from] = str->data[i];
+    memmove(str->data + pos + length_from, str->data + pos, str->size_m - pos);
     memcpy(str->data + pos, from, length_from);
     str->size_m += length_from;
+    str->hash_m = 0;
 
     return 0;
 }
@@ -292,11 +414,13 @@ int my_str_append(my_str_t* str, const my_str_t* from){
     if (!str || !from)
         return NULL_PTR_ERR;
 
-    int err = my_str_reserve(str, str->capacity_m + from->capacity_m);
+    char* spare;
+    int err = my_str_reserve_uninit(str, from->size_m, &spare);
     if (err != 0) return err;
 
-    memcpy(str->data + str->size_m, from->data, from->size_m);
+    memcpy(spare, from->data, from->size_m);
     str->size_m += from->size_m;
+    str->hash_m = 0;
 
     return 0;
 }
@@ -310,11 +434,13 @@ int my_str_append_cstr(my_str_t* str, const char* from){
         return NULL_PTR_ERR;
 
     size_t length_from = length_cstr(from);
-    int err = my_str_reserve(str, str->capacity_m + length_from);
+    char* spare;
+    int err = my_str_reserve_uninit(str, length_from, &spare);
     if (err != 0)  return err;
 
-    memcpy(str->data + str->size_m, from, length_from);
+    memcpy(spare, from, length_from);
     str->size_m += length_from;
+    str->hash_m = 0;
     return 0;
 }
 
@@ -330,12 +456,17 @@ int my_str_append_c(my_str_t* str, char c) {
     if (!str || !c)
         return NULL_PTR_ERR;
 
+    int err = unshare(str);
+    if (err != 0) return err;
+
     if (str->capacity_m == str->size_m) {
-        int err = my_str_reserve(str, str->capacity_m * 2);
+        char* spare;
+        err = my_str_reserve_uninit(str, 1, &spare);
         if (err != 0) return err;
     }
 
     str->data[str->size_m++] = c;
+    str->hash_m = 0;
 
     return 0;
 }
@@ -358,11 +489,91 @@ int my_str_substr(const my_str_t* from, my_str_t* to, size_t beg, size_t end) {
     // so not to allocate much memory, let's bound the end index
     end = end < from->size_m ? end : from->size_m;
 
-    int err = my_str_reserve(to, (end - beg) * 2 + 1);
+    int err = my_str_reserve(to, end - beg);
     if (err != 0) return err;
 
     memcpy(to->data, from->data + beg, end - beg);
     to->size_m = end - beg;
+    to->hash_m = 0;
+
+    return 0;
+}
+
+/*
+ * makes given my_str-string a substring of from in given bounds without copying:
+ * both strings point into one refcounted buffer, and any of them is copied only when
+ * it is changed; substrings shorter than MY_STR_SHARE_MIN are just copied
+ * to must be created and differ from from
+ * reference count is atomic (with GCC and Clang), so strings sharing a buffer may be used by
+ * different threads; one string still must not be used by several threads at once
+ * return:
+ *      0  if oK
+ *      NULL_PTR_ERR if from or to is NULL
+ *      RANGE_ERR if boundaries are bad or from == to
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_substr_shared(my_str_t* from, my_str_t* to, size_t beg, size_t end) {
+    if (!from || !to)
+        return NULL_PTR_ERR;
+
+    if (beg > end || beg > from->size_m || from == to)
+        return RANGE_ERR;
+
+    end = end < from->size_m ? end : from->size_m;
+
+    // header of shared buffer costs more than copy of short substring
+    if (end - beg < MY_STR_SHARE_MIN)
+        return my_str_substr(from, to, beg, end);
+
+    if (!from->shared) {
+        my_str_shared_t* shared = (my_str_shared_t *) malloc(sizeof(my_str_shared_t));
+        if (!shared)
+            return MEMORY_ALLOCATION_ERR;
+        shared->refs = 1;
+        shared->data = from->data;
+        shared->capacity_m = from->capacity_m;
+        shared->size_m = from->size_m;
+        from->shared = shared;
+    }
+
+    // the shared buffer is referenced before the old content of to is released,
+    // because to may already share the same buffer
+    REFS_ADD(from->shared->refs);
+    my_str_free(to);
+    to->data = from->data + beg;
+    to->size_m = end - beg;
+    to->capacity_m = end - beg;
+    to->hash_m = 0;
+    to->shared = from->shared;
+
+    return 0;
+}
+
+/*
+ * copies shared substring into own buffer if it is smaller than 1/MY_STR_COMPACT_RATIO of
+ * the buffer it points into, so tiny substrings do not keep huge buffers alive;
+ * does nothing for other strings
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_compact(my_str_t* str) {
+    if (!str)
+        return NULL_PTR_ERR;
+
+    if (!str->shared || str->size_m >= str->shared->capacity_m / MY_STR_COMPACT_RATIO)
+        return 0;
+
+    my_str_t copy;
+    int err = my_str_create(&copy, str->size_m);
+    if (err != 0) return err;
+
+    memcpy(copy.data, str->data, str->size_m);
+    copy.size_m = str->size_m;
+    copy.hash_m = str->hash_m;
+    my_str_free(str);
+    *str = copy;
 
     return 0;
 }
@@ -382,7 +593,10 @@ int my_str_substr_cstr(const my_str_t* from, char* to, size_t beg, size_t end) {
     if (beg > end || beg > from->size_m)
         return RANGE_ERR;
 
-    memcpy(to,  (from->data + beg), end - beg);
+    // bytes after the content are not read, rest of requested range is filled with zeros
+    size_t copied = (end < from->size_m ? end : from->size_m) - beg;
+    memcpy(to,  (from->data + beg), copied);
+    memset(to + copied, 0, end - beg - copied);
 
     return 0;
 }
@@ -406,12 +620,15 @@ int my_str_erase(my_str_t* str, size_t beg, size_t end){
     if (beg > str->size_m || end < beg)
         return RANGE_ERR;
 
+    int err = unshare(str);
+    if (err != 0) return err;
+
     size_t erase_seg = end - beg;
     memmove(str->data + beg, str->data + end, str->size_m - end);
 
     str->size_m -= erase_seg;
-    int err = my_str_reserve(str, str->capacity_m - erase_seg);
-    if (err != 0) return err;
+    str->hash_m = 0;
+    shrink(str);
 
     return 0;
 }
@@ -430,9 +647,14 @@ int my_str_popback(my_str_t* str) {
     if (str->size_m == 0)
         return RANGE_ERR;
 
+    int err = unshare(str);
+    if (err != 0) return err;
+
     str->size_m--;
+    str->hash_m = 0;
     char popped = str->data[str->size_m];
     str->data[str->size_m] = '\0';
+    shrink(str);
 
     return popped;
 }
@@ -440,6 +662,7 @@ int my_str_popback(my_str_t* str) {
 /*
  * increases given my_str-string's buffer to given value.
  * if buf_size < my_str-string capacity, does nothing
+ * new buffer is aligned and padded, as described at my_str_t
  * return:
  *      0  if OK
  *      NULL_PTR_ERR if str is NULL
@@ -449,30 +672,99 @@ int my_str_reserve(my_str_t* str, size_t buf_size) {
     if (!str)
         return NULL_PTR_ERR;
 
+    // buffer is reserved to be written, so shared one is copied first
+    int err = unshare(str);
+    if (err != 0) return err;
+
     // does nothing if capacity is larger than buffer
     if (buf_size <= str->capacity_m)
         return 0;
 
-    int err = 0;
-    my_str_t larger_str = {0};
-    err = my_str_create(&larger_str, buf_size);
-    if (err != 0) return  err;
+    // realloc does not keep the alignment, so only the content is copied to new buffer,
+    // and pages of huge buffers are moved
+    return move_buffer(str, buf_size);
+}
+
+/*
+ * makes place for at least extra bytes after the content without initializing them,
+ * so producers (read, decoders, formatters) can write there directly;
+ * written bytes become part of the string after my_str_commit
+ * buffer grows at least twice if it grows
+ * spare: pointer to the first byte after the content is saved there
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str or spare is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_reserve_uninit(my_str_t* str, size_t extra, char** spare) {
+    if (!str || !spare)
+        return NULL_PTR_ERR;
 
-    memcpy(larger_str.data, str->data, str->size_m);
-    larger_str.size_m = str->size_m;
+    if (extra > SIZE_MAX - 1 - str->size_m)
+        return MEMORY_ALLOCATION_ERR;
 
-    my_str_free(str);
+    size_t needed = str->size_m + extra;
+    size_t doubled = (str->capacity_m > SIZE_MAX / 4) ? needed : str->capacity_m * 2;
+    int err = my_str_reserve(str, (needed > str->capacity_m && doubled > needed) ? doubled : needed);
+    if (err != 0) return err;
+
+    *spare = str->data + str->size_m;
+    return 0;
+}
+
+/*
+ * appends written bytes that are already in the buffer after the content
+ * (usually after my_str_reserve_uninit) to the string
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ *      RANGE_ERR if written is bigger than free space of the buffer
+ */
+int my_str_commit(my_str_t* str, size_t written) {
+    if (!str)
+        return NULL_PTR_ERR;
+
+    // free space of shared buffer is not writable, reserve gives own buffer
+    if (written > str->capacity_m - str->size_m || (str->shared && written))
+        return RANGE_ERR;
+
+    str->size_m += written;
+    str->hash_m = 0;
+
+    return 0;
+}
+
+/*
+ * replaces content of the string by what callback writes directly into the buffer:
+ * callback gets buffer with max_size bytes, where old content is kept but the rest is not
+ * initialized, and returns new size
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str or callback is NULL
+ *      RANGE_ERR if callback returned size bigger than max_size, string is empty then
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_resize_and_overwrite(my_str_t* str, size_t max_size, my_str_overwrite_callback callback, void* arg) {
+    if (!str || !callback)
+        return NULL_PTR_ERR;
+
+    int err = my_str_reserve(str, max_size);
+    if (err != 0) return err;
 
-    // redirects the pointer of newly created string to the str
-    str->data = larger_str.data;
-    str->size_m = larger_str.size_m;
-    str->capacity_m = larger_str.capacity_m;
+    size_t size = callback(str->data, max_size, arg);
+    str->hash_m = 0;
+    if (size > max_size) {
+        str->size_m = 0;
+        return RANGE_ERR;
+    }
 
+    str->size_m = size;
     return 0;
 }
 
 /*
  * decreases buffer of given my_str-string to size of string
+ * new buffer is aligned and padded, as described at my_str_t
  * return:
  *      0  if OK
  *      NULL_PTR_ERR if from ot str is NULL
@@ -482,22 +774,36 @@ int my_str_shrink_to_fit(my_str_t* str){
     if (!str)
         return NULL_PTR_ERR;
 
-    my_str_t new_string = {0};
-    int err = my_str_create(&new_string, str->size_m);
+    int err = unshare(str);
     if (err != 0) return err;
 
-    err = my_str_copy(str, &new_string, 0);
-    if (err != 0) return err;
+    if (str->data && str->capacity_m == str->size_m)
+        return 0;
 
-    my_str_free(str);
+    return move_buffer(str, str->size_m);
+}
 
-    str->data = new_string.data;
-    str->size_m = new_string.size_m;
-    str->capacity_m = new_string.capacity_m;
 
+/*
+ * sets shrink policy for all my_str-strings, should be set before strings are used by threads
+ * return:
+ *      0  if OK
+ *      RANGE_ERR if trigger is not 0 and factor is 0 or not smaller than trigger
+ */
+int my_str_set_shrink_policy(my_str_shrink_policy_t policy) {
+    if (policy.trigger && (!policy.factor || policy.factor >= policy.trigger))
+        return RANGE_ERR;
+
+    shrink_policy = policy;
     return 0;
 }
 
+/*
+ * returns current shrink policy
+ */
+my_str_shrink_policy_t my_str_get_shrink_policy(void) {
+    return shrink_policy;
+}
 
 /*
  * resizes my_str-string to given size.
@@ -511,35 +817,189 @@ int my_str_resize(my_str_t* str, size_t new_size, char sym){
     if (!str)
         return NULL_PTR_ERR;
 
+    int err = unshare(str);
+    if (err != 0) return err;
+
     if (new_size > str->capacity_m){
-        int err = my_str_reserve(str, 2 * new_size);
+        err = my_str_reserve(str, (new_size > SIZE_MAX / 2) ? new_size : 2 * new_size);
         if (err != 0) return err;
     }
 
     if (new_size > str->size_m)
         memset(str->data + str->size_m, (int) sym, new_size - str->size_m);
     str->size_m = new_size;
+    str->hash_m = 0;
+    shrink(str);
 
     return 0;
 }
 
+/*
+ * returns position of the first occurrence of tofind in my_str-string, starting from given position
+ * errors are cast to size_t, so my_str_find_pos should be used when they must be told apart
+ * return:
+ *      position of tofind if it is in string
+ *      (size_t) NOT_FOUND_CODE if it's not in string, empty tofind is never found
+ *      (size_t) NULL_PTR_ERR if str or tofind is NULL
+ */
 size_t my_str_find(const my_str_t* str, const my_str_t* tofind, size_t from) {
-    if (!str || !tofind)
-        return (size_t) NULL_PTR_ERR;
+    size_t pos;
+    int err = my_str_find_pos(str, tofind, from, &pos);
+    return (err != 0) ? (size_t) err : pos;
+}
+
+/*
+ * finds the first occurrence of tofind in my_str-string starting from given position and
+ * writes its position to pos; positions are size_t, so strings of any size are searched
+ * return:
+ *      0  if found
+ *      NOT_FOUND_CODE if it's not in string, empty tofind is never found
+ *      NULL_PTR_ERR if str, tofind or pos is NULL
+ */
+int my_str_find_pos(const my_str_t* str, const my_str_t* tofind, size_t from, size_t* pos) {
+    if (!str || !tofind || !pos)
+        return NULL_PTR_ERR;
 
     size_t t_n = str->size_m;
     size_t p_n = tofind->size_m;
-    for (size_t i = from; i < t_n; i++) {
-        size_t j;
-        for (j = 0; j < p_n; j++) {
-            if (str->data[i + j] != tofind->data[j])
-                break;
+    if (p_n == 0 || p_n > t_n)
+        return NOT_FOUND_CODE;
+
+    // candidates are only positions of the first symbol, they are found block by block
+    size_t last = t_n - p_n;
+    for (size_t i = find_byte(str->data, from, last + 1, tofind->data[0]); i <= last;
+         i = find_byte(str->data, i + 1, last + 1, tofind->data[0])) {
+        if (memcmp(str->data + i + 1, tofind->data + 1, p_n - 1) == 0) {
+            *pos = i;
+            return 0;
+        }
+    }
+
+    return NOT_FOUND_CODE;
+}
+
+/*
+ * returns 64-bit hash of given bytes (wyhash), equal content and seed always give equal hash
+ * seed: allows to get independent hash functions, e.g. for per-process randomization
+ * if data == NULL than hash of empty data is returned
+ */
+uint64_t my_str_hash_bytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = (const unsigned char *) data;
+    if (!p) size = 0;
+
+    uint64_t a, b;
+    seed ^= hash_mix(seed ^ hash_secret[0], hash_secret[1]);
+    if (size <= 16) {
+        if (size >= 4) {
+            // two overlapping pairs of 4-byte words cover all the bytes
+            size_t shift = (size >> 3) << 2;
+            a = (hash_read4(p) << 32) | hash_read4(p + shift);
+            b = (hash_read4(p + size - 4) << 32) | hash_read4(p + size - 4 - shift);
+        } else if (size > 0) {
+            a = ((uint64_t) p[0] << 16) | ((uint64_t) p[size >> 1] << 8) | p[size - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t left = size;
+        if (left >= 48) {
+            // three independent lanes hide the latency of multiplication
+            uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+                seed1 = hash_mix(hash_read8(p + 16) ^ hash_secret[2], hash_read8(p + 24) ^ seed1);
+                seed2 = hash_mix(hash_read8(p + 32) ^ hash_secret[3], hash_read8(p + 40) ^ seed2);
+                p += 48;
+                left -= 48;
+            } while (left >= 48);
+            seed ^= seed1 ^ seed2;
         }
-        if (j == p_n && p_n != 0)
-            return i;
+        while (left > 16) {
+            seed = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+            p += 16;
+            left -= 16;
+        }
+        a = hash_read8(p + left - 16);
+        b = hash_read8(p + left - 8);
     }
 
-    return (size_t)NOT_FOUND_CODE;
+    a ^= hash_secret[1];
+    b ^= seed;
+    hash_multiply(&a, &b);
+    return hash_mix(a ^ hash_secret[0] ^ size, b ^ hash_secret[1]);
+}
+
+/*
+ * returns 64-bit hash of my_str-string content, the same as my_str_hash_bytes over its data
+ * if str == NULL than hash of empty string is returned
+ */
+uint64_t my_str_hash(const my_str_t* str, uint64_t seed) {
+    if (!str)
+        return my_str_hash_bytes(NULL, 0, seed);
+
+    return my_str_hash_bytes(str->data, str->size_m, seed);
+}
+
+/*
+ * returns 64-bit hash of the viewed content, the same as my_str_hash_bytes over its data
+ */
+uint64_t my_str_hash_view(my_str_view_t view, uint64_t seed) {
+    return my_str_hash_bytes(view.data, view.size_m, seed);
+}
+
+/*
+ * returns my_str_hash with seed 0 and remembers it in the string, so repeated calls
+ * do not rehash; all functions that change the string forget remembered hash
+ * !important! if data of the string is changed directly, my_str_hash_invalidate should be called
+ * if str == NULL than hash of empty string is returned
+ */
+uint64_t my_str_hash_cached(my_str_t* str) {
+    if (!str)
+        return my_str_hash_bytes(NULL, 0, 0);
+
+    // hash that is really 0 is simply never remembered
+    if (str->hash_m == 0)
+        str->hash_m = my_str_hash(str, 0);
+
+    return str->hash_m;
+}
+
+/*
+ * forgets hash remembered by my_str_hash_cached
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ */
+int my_str_hash_invalidate(my_str_t* str) {
+    if (!str)
+        return NULL_PTR_ERR;
+
+    str->hash_m = 0;
+
+    return 0;
+}
+
+/*
+ * checks whether two my_str-strings have the same content
+ * if hashes of both strings are remembered, strings with different hashes are rejected
+ * without looking at their content
+ * return:
+ *      1 if str1 == str2
+ *      0 if str1 != str2
+ *      NULL_PTR_ERR if str1 or str2 is NULL
+ */
+int my_str_equal(const my_str_t* str1, const my_str_t* str2) {
+    if (!str1 || !str2)
+        return NULL_PTR_ERR;
+
+    if (str1->size_m != str2->size_m)
+        return 0;
+
+    if (str1->hash_m && str2->hash_m && str1->hash_m != str2->hash_m)
+        return 0;
+
+    return (str1->size_m == 0 || memcmp(str1->data, str2->data, str1->size_m) == 0) ? 1 : 0;
 }
 
 /*
@@ -554,7 +1014,16 @@ int my_str_cmp(const my_str_t* str1, const my_str_t* str2){
     if (!str1 || !str2)
         return NULL_PTR_ERR;
 
-    return my_str_cmp_cstr(str1, my_str_get_cstr((my_str_t *) str2));
+    // compared in place, so that substrings that share buffer are not copied
+    size_t common = (str1->size_m < str2->size_m) ? str1->size_m : str2->size_m;
+    int diff = common ? memcmp(str1->data, str2->data, common) : 0;
+    if (diff != 0)
+        return (diff < 0) ? -1 : 1;
+
+    if (str1->size_m == str2->size_m)
+        return 0;
+
+    return (common == str1->size_m) ? -1 : 1;
 }
 
 /*
@@ -565,19 +1034,17 @@ int my_str_cmp_cstr(const my_str_t* str1, const char* cstr2){
     if (!str1 || !cstr2)
         return NULL_PTR_ERR;
 
-    size_t i = 0;
     size_t second_length = length_cstr(cstr2);
-    for (; i < str1->size_m && i < second_length; i++){
-        if (str1->data[i] == cstr2[i])
-            continue;
-        return (str1->data[i] < cstr2[i]) ? -1 : 1;
-    }
+    size_t common = (str1->size_m < second_length) ? str1->size_m : second_length;
+    int diff = common ? memcmp(str1->data, cstr2, common) : 0;
+    if (diff != 0)
+        return (diff < 0) ? -1 : 1;
 
     // two string are equal
-    if (i == str1->size_m && i == second_length)
+    if (str1->size_m == second_length)
         return 0;
 
-    return (i == str1->size_m) ? -1 : 1;
+    return (common == str1->size_m) ? -1 : 1;
 }
 
 /*
@@ -587,16 +1054,37 @@ int my_str_cmp_cstr(const my_str_t* str1, const char* cstr2){
  *      position of char symbol if its in string
  *      NOT_FOUND_CODE if it's not in string
  *      NULL_PTR_ERR if str is NULL
+ *      RANGE_ERR if position does not fit in int, my_str_find_c_pos works for such strings
  */
 int my_str_find_c(const my_str_t* str, char tofind, size_t from) {
     if (!str || !tofind)
         return NULL_PTR_ERR;
 
-    for (size_t i = from; i < str->size_m; i++)
-        if (str->data[i] == tofind)
-            return i;
+    size_t pos;
+    int err = my_str_find_c_pos(str, tofind, from, &pos);
+    if (err != 0) return err;
 
-    return NOT_FOUND_CODE;
+    return (pos > INT_MAX) ? RANGE_ERR : (int) pos;
+}
+
+/*
+ * finds given symbol (including '\0') in my_str-string starting from given position
+ * and writes its position to pos
+ * return:
+ *      0  if found
+ *      NOT_FOUND_CODE if it's not in string
+ *      NULL_PTR_ERR if str or pos is NULL
+ */
+int my_str_find_c_pos(const my_str_t* str, char tofind, size_t from, size_t* pos) {
+    if (!str || !pos)
+        return NULL_PTR_ERR;
+
+    size_t found = find_byte(str->data, from, str->size_m, tofind);
+    if (found >= str->size_m)
+        return NOT_FOUND_CODE;
+
+    *pos = found;
+    return 0;
 }
 
 /*
@@ -605,14 +1093,33 @@ int my_str_find_c(const my_str_t* str, char tofind, size_t from) {
  *      position of char symbol that satisfies predicate
  *      NOT_FOUND_CODE if it's not in string
  *      NULL_PTR_ERR if str or predicate is NULL
+ *      RANGE_ERR if position does not fit in int, my_str_find_if_pos works for such strings
  */
 int my_str_find_if(const my_str_t* str, size_t beg, int (*predicat)(int)) {
-    if (!str || !predicat)
+    size_t pos;
+    int err = my_str_find_if_pos(str, beg, predicat, &pos);
+    if (err != 0) return err;
+
+    return (pos > INT_MAX) ? RANGE_ERR : (int) pos;
+}
+
+/*
+ * finds symbol that predicate on it returns 1 starting from beg and writes its position to pos
+ * return:
+ *      0  if found
+ *      NOT_FOUND_CODE if it's not in string
+ *      NULL_PTR_ERR if str, predicate or pos is NULL
+ */
+int my_str_find_if_pos(const my_str_t* str, size_t beg, int (*predicat)(int), size_t* pos) {
+    if (!str || !predicat || !pos)
         return NULL_PTR_ERR;
 
-    for (size_t i = beg; i < str->size_m; i++)
-        if (predicat((int)str->data[i]) == 1)
-            return i;
+    for (size_t i = beg; i < str->size_m; i++) {
+        if (predicat((int)str->data[i]) == 1) {
+            *pos = i;
+            return 0;
+        }
+    }
 
     return NOT_FOUND_CODE;
 }
@@ -651,6 +1158,9 @@ int my_str_read_file(my_str_t* str, FILE* file) {
 
 /*
  * reads content from stdin and saves to my_str-string
+ * if stdio did not buffer anything from stdin yet, it is read by my_str_read_fd with large read(2)
+ * calls; otherwise (or if C library does not let us check it) stdio is used, so that already
+ * buffered bytes are not lost
  * return:
  *      0  if OK
  *      NULL_PTR_ERR if str is NULL
@@ -660,16 +1170,121 @@ int my_str_read_file(my_str_t* str, FILE* file) {
 int my_str_read(my_str_t* str) {
     if (!str) return NULL_PTR_ERR;
 
-    int err = my_str_read_file(str, stdin);
+    int err = stdio_buffer_empty(stdin) ? my_str_read_fd(str, fileno(stdin), 0) : my_str_read_file(str, stdin);
     if (err != 0) return err;
 
     // ugly, though better fixes require std functions for
     // working with c strings (deletes trailing whitespace)
-    str->size_m = (str->data[str->size_m-1] == '\n') ? str->size_m - 1 : str->size_m;
+    if (str->size_m > 0 && str->data[str->size_m - 1] == '\n') {
+        str->size_m--;
+        str->hash_m = 0;
+    }
+
+    return 0;
+}
+
+/*
+ * reads everything from given file descriptor (usually pipe or stdin) up to EOF into my_str-string
+ * uses large read(2) calls directly into the string buffer, which grows geometrically
+ * size_hint: expected number of bytes, buffer is reserved for it up front; if 0 and fd is a
+ * regular file, rest of the file size is used as a hint
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during increasing buffer
+ *      IO_READ_ERR if fd is bad or there was error while reading
+ */
+int my_str_read_fd(my_str_t* str, int fd, size_t size_hint) {
+    if (!str)
+        return NULL_PTR_ERR;
+
+    if (fd < 0)
+        return IO_READ_ERR;
+
+    str->size_m = 0;
+    str->hash_m = 0;
+
+    struct stat st;
+    int exact_hint = 0;
+    if (!size_hint && fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        off_t offset = lseek(fd, 0, SEEK_CUR);
+        if (offset >= 0) {
+            size_hint = (st.st_size > offset) ? (size_t) (st.st_size - offset) : 0;
+            exact_hint = 1;
+        }
+    }
+
+    // one byte over the hint lets us see EOF without growing the buffer
+    size_hint = (size_hint || exact_hint) ? size_hint : READ_CHUNK_SIZE;
+    int err = my_str_reserve(str, (size_hint < SIZE_MAX) ? size_hint + 1 : size_hint);
+    if (err != 0) return err;
+
+    for (;;) {
+        if (str->size_m == str->capacity_m) {
+            // grows geometrically, but never reads less than READ_CHUNK_SIZE at once
+            if (str->capacity_m > SIZE_MAX / 2)
+                return MEMORY_ALLOCATION_ERR;
+            size_t new_capacity = str->capacity_m * 2;
+            new_capacity = (new_capacity < str->capacity_m + READ_CHUNK_SIZE) ?
+                           str->capacity_m + READ_CHUNK_SIZE : new_capacity;
+            err = my_str_reserve(str, new_capacity);
+            if (err != 0) return err;
+        }
+
+        // larger reads are implementation defined
+        size_t free_space = str->capacity_m - str->size_m;
+        ssize_t n = read(fd, str->data + str->size_m, (free_space < SSIZE_MAX) ? free_space : SSIZE_MAX);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return IO_READ_ERR;
+        }
+        if (n == 0) break;
+        str->size_m += (size_t) n;
+    }
 
     return 0;
 }
 
+/*
+ * reads given file descriptor up to EOF and hands every chunk to callback as soon as it arrives
+ * nothing is accumulated, chunk is valid only during the callback call
+ * chunk_size: size of read buffer, if 0 then READ_CHUNK_SIZE is used
+ * callback: is called with chunk, its size and given arg; non zero return stops reading
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if callback is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during allocating read buffer
+ *      IO_READ_ERR if fd is bad or there was error while reading
+ *      else - non zero value returned by callback
+ */
+int my_str_read_fd_chunks(int fd, size_t chunk_size, my_str_chunk_callback callback, void* arg) {
+    if (!callback)
+        return NULL_PTR_ERR;
+
+    if (fd < 0)
+        return IO_READ_ERR;
+
+    chunk_size = chunk_size ? chunk_size : READ_CHUNK_SIZE;
+    char* buf = (char *) malloc(chunk_size);
+    if (!buf)
+        return MEMORY_ALLOCATION_ERR;
+
+    int err = 0;
+    while (err == 0) {
+        ssize_t n = read(fd, buf, chunk_size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            err = IO_READ_ERR;
+            break;
+        }
+        if (n == 0) break;
+        err = callback(buf, (size_t) n, arg);
+    }
+
+    free(buf);
+    return err;
+}
+
 /*
  * reads file and saves it's content into my_str-string, stops when reached delimiter or EOF
  * return:
@@ -718,9 +1333,9 @@ int my_str_write_file(const my_str_t* str, FILE* file) {
     if (!str || !file)
         return NULL_PTR_ERR;
 
-    str->data[str->size_m] = '\0';
-    int err = fputs(str->data, file);
-    if (err == EOF) return IO_WRITE_ERR;
+    // nothing is written into the string, its buffer may be shared
+    if (fwrite(str->data, 1, str->size_m, file) != str->size_m)
+        return IO_WRITE_ERR;
 
     return 0;
 }
@@ -736,11 +1351,411 @@ int my_str_write(const my_str_t* str) {
     return my_str_write_file(str, stdout);
 }
 
+/*
+ * writes content of given my_str-string to given file descriptor (file, pipe or socket)
+ * without going through stdio buffers; retries on partial writes and EINTR
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ *      IO_WRITE_ERR if fd is bad or error occurred while writing
+ */
+int my_str_write_fd(const my_str_t* str, int fd) {
+    if (!str)
+        return NULL_PTR_ERR;
+
+    if (fd < 0)
+        return IO_WRITE_ERR;
+
+    return write_all_fd(fd, str->data, str->size_m);
+}
+
+/*
+ * transfers count bytes (or everything up to EOF if count == SIZE_MAX) from the current
+ * position of given file to given file descriptor without copying them into a my_str-string.
+ * on linux the data is moved by the kernel (copy_file_range for file to file, sendfile for
+ * file to pipe or socket), otherwise or if kernel refuses, plain read/write loop is used.
+ * position of file is advanced by the number of transferred bytes
+ * transferred: if not NULL, number of transferred bytes is saved there
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if from is NULL
+ *      IO_READ_ERR if error occurred while reading
+ *      IO_WRITE_ERR if fd is bad or error occurred while writing
+ */
+int my_str_transfer_file(FILE* from, int fd, size_t count, size_t* transferred) {
+    if (!from)
+        return NULL_PTR_ERR;
+
+    if (transferred) *transferred = 0;
+    if (fd < 0)
+        return IO_WRITE_ERR;
+
+    // stdio may hold already read data in its buffer, so the kernel can be asked to move
+    // data only when we know the logical position in a seekable file
+    off_t offset = ftello(from);
+    int in_fd = fileno(from);
+    struct stat st;
+    if (offset < 0 || in_fd < 0 || fstat(in_fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return transfer_file_stdio(from, fd, count, transferred);
+
+    size_t done = 0;
+    size_t left = (st.st_size > offset) ? (size_t) (st.st_size - offset) : 0;
+    left = (count < left) ? count : left;
+
+    int err = 0;
+#ifdef __linux__
+    // copy_file_range works only between regular files, sendfile accepts any output
+    int use_copy_range = 1, use_sendfile = 1;
+    while (left > 0 && (use_copy_range || use_sendfile)) {
+        ssize_t n = -1;
+        if (use_copy_range) {
+            n = copy_file_range(in_fd, &offset, fd, NULL, left, 0);
+            if (n < 0 && errno != EINTR) {
+                use_copy_range = 0;
+                continue;
+            }
+        } else {
+            n = sendfile(fd, in_fd, &offset, left);
+            if (n < 0 && errno != EINTR) {
+                use_sendfile = 0;
+                continue;
+            }
+        }
+        if (n < 0) continue; // interrupted
+        if (n == 0) break;   // file was truncated
+        done += (size_t) n;
+        left -= (size_t) n;
+    }
+#endif
+
+    // fallback for systems or descriptors the kernel transfer does not support
+    char buf[BUF_SIZE];
+    while (left > 0 && err == 0) {
+        size_t chunk = (left < BUF_SIZE) ? left : BUF_SIZE;
+        ssize_t n = pread(in_fd, buf, chunk, offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            err = IO_READ_ERR;
+            break;
+        }
+        if (n == 0) break;
+
+        // bytes that were not written are not counted, stream stays before them
+        err = write_all_fd(fd, buf, (size_t) n);
+        if (err != 0) break;
+        offset += n;
+        done += (size_t) n;
+        left -= (size_t) n;
+    }
+
+    // keeps the stream position consistent with what was transferred
+    if (fseeko(from, offset, SEEK_SET) != 0 && err == 0)
+        err = IO_READ_ERR;
+
+    if (transferred) *transferred = done;
+    return err;
+}
+
+// writes whole buffer to the file descriptor, retrying on partial writes
+static int write_all_fd(int fd, const char* buf, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, buf, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return IO_WRITE_ERR;
+        }
+        buf += n;
+        size -= (size_t) n;
+    }
+
+    return 0;
+}
+
+// transfers data through the stdio buffer, used for pipes and other unseekable streams
+static int transfer_file_stdio(FILE* from, int fd, size_t count, size_t* transferred) {
+    char buf[BUF_SIZE];
+    size_t done = 0;
+
+    while (done < count) {
+        size_t chunk = (count - done < BUF_SIZE) ? count - done : BUF_SIZE;
+        size_t n = fread(buf, 1, chunk, from);
+        if (n == 0) break;
+
+        int err = write_all_fd(fd, buf, n);
+        if (err != 0) return err;
+        done += n;
+        if (transferred) *transferred = done;
+    }
+
+    return ferror(from) ? IO_READ_ERR : 0;
+}
+
+// checks that stdio has no buffered or pushed back bytes of the stream, so reading its
+// descriptor directly skips nothing
+static int stdio_buffer_empty(FILE* file) {
+    if (feof(file) || ferror(file))
+        return 0;
+
+    return !stdio_may_have_read_ahead(file);
+}
+
+// returns 0 only if stdio surely keeps no bytes read ahead from the stream
+// !portability! C and POSIX give no way to check it, so private fields of FILE of glibc and
+// BSD libc are read (their layout may change in new versions); streams of other C libraries
+// are always treated as having read ahead bytes, so my_str_read keeps using stdio for them
+static int stdio_may_have_read_ahead(FILE* file) {
+#if defined(__GLIBC__)
+    return file->_IO_read_ptr < file->_IO_read_end;
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+    return file->_r > 0;
+#else
+    (void) file;
+    return 1;
+#endif
+}
+
+// 64x64 -> 128 bit multiplication, low half is saved to a, high half to b
+static void hash_multiply(uint64_t* a, uint64_t* b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ unsigned __int128 r = (unsigned __int128) *a * *b;
+    *a = (uint64_t) r;
+    *b = (uint64_t) (r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static uint64_t hash_mix(uint64_t a, uint64_t b) {
+    hash_multiply(&a, &b);
+    return a ^ b;
+}
+
+// unaligned reads, memcpy is compiled into single load
+static uint64_t hash_read8(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint64_t hash_read4(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
 // function, which calculate length of c-string with assumption that str!=NULL
 static size_t length_cstr(const char * str){
-    int length= 0;
-    for (; str[length] != '\0'; length++);
+    return strlen(str);
+}
+
+// gives str own buffer with the same content if it shares one with other strings
+static int unshare(my_str_t* str) {
+    my_str_shared_t* shared = str->shared;
+    if (!shared)
+        return 0;
+
+    // the last string takes the whole buffer
+    if (REFS_GET(shared->refs) == 1) {
+        memmove(shared->data, str->data, str->size_m);
+        str->data = shared->data;
+        str->capacity_m = shared->capacity_m;
+        str->shared = NULL;
+        free(shared);
+        return 0;
+    }
+
+    char* data = alloc_buffer(str->size_m);
+    if (!data)
+        return MEMORY_ALLOCATION_ERR;
 
-    return length;
+    // other strings may release the buffer meanwhile, so this one can turn out to be the last
+    memcpy(data, str->data, str->size_m);
+    release_shared(str);
+    str->data = data;
+    str->capacity_m = str->size_m;
+    str->shared = NULL;
+    return 0;
 }
 
+// drops reference of str to the shared buffer, str is left without buffer
+static void release_shared(my_str_t* str) {
+    my_str_shared_t* shared = str->shared;
+    if (REFS_SUB(shared->refs) == 0) {
+        free_buffer(shared->data, shared->capacity_m);
+        free(shared);
+    }
+    str->data = NULL;
+    str->shared = NULL;
+}
+
+// shrinks buffer if the policy says so, on failure buffer is just kept
+static void shrink(my_str_t* str) {
+    if (!shrink_policy.trigger || str->shared || !str->data)
+        return;
+
+    if (str->size_m > SIZE_MAX / shrink_policy.trigger || str->size_m * shrink_policy.trigger >= str->capacity_m)
+        return;
+
+    size_t capacity = str->size_m * shrink_policy.factor;
+    capacity = (capacity < shrink_policy.min_capacity) ? shrink_policy.min_capacity : capacity;
+    if (capacity >= str->capacity_m)
+        return;
+
+    move_buffer(str, capacity);
+}
+
+// allocates MY_STR_ALIGN aligned buffer for capacity bytes and '\0', followed by zeroed padding
+static char* alloc_buffer(size_t capacity) {
+    if (capacity > MAX_CAPACITY)
+        return NULL;
+
+    // mapped memory is zeroed, so is the padding
+    if (capacity >= MY_STR_HUGE_MIN)
+        return map_huge(huge_size(capacity));
+
+    size_t bytes = (capacity + 1 + MY_STR_PADDING + MY_STR_ALIGN - 1) & ~((size_t) MY_STR_ALIGN - 1);
+    void* data = NULL;
+    if (posix_memalign(&data, MY_STR_ALIGN, bytes) != 0)
+        return NULL;
+
+    memset((char *) data + capacity + 1, 0, bytes - capacity - 1);
+    return (char *) data;
+}
+
+// buffer is freed the way it was allocated, which is known from its capacity
+static void free_buffer(char* data, size_t capacity) {
+    if (!data)
+        return;
+
+    if (capacity >= MY_STR_HUGE_MIN)
+        munmap(data, huge_size(capacity));
+    else
+        free(data);
+}
+
+// mapped size of huge buffer with given capacity, whole huge pages
+static size_t huge_size(size_t capacity) {
+    return (capacity + 1 + MY_STR_PADDING + MY_STR_HUGE_PAGE - 1) & ~(MY_STR_HUGE_PAGE - 1);
+}
+
+// maps bytes at MY_STR_HUGE_PAGE boundary, so that they can be backed by whole huge pages
+static char* map_huge(size_t bytes) {
+    size_t mapped = bytes + MY_STR_HUGE_PAGE;
+    char* area = (char *) mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (area == MAP_FAILED)
+        return NULL;
+
+    // unaligned head and the rest of the tail are unmapped
+    char* data = (char *) (((uintptr_t) area + MY_STR_HUGE_PAGE - 1) & ~(uintptr_t) (MY_STR_HUGE_PAGE - 1));
+    if (data != area)
+        munmap(area, (size_t) (data - area));
+    if (data + bytes != area + mapped)
+        munmap(data + bytes, (size_t) (area + mapped - data - bytes));
+
+#ifdef MADV_HUGEPAGE
+    // only advice, without transparent huge pages buffer just uses normal ones
+    madvise(data, bytes, MADV_HUGEPAGE);
+#endif
+    return data;
+}
+
+#ifdef __linux__
+// resizes huge buffer by moving its pages instead of copying content, alignment is kept
+static char* remap_huge(char* data, size_t old_bytes, size_t bytes) {
+    if (old_bytes == bytes || mremap(data, old_bytes, bytes, 0) != MAP_FAILED)
+        return data;
+
+    // can not grow in place, pages are moved to the beginning of new aligned mapping
+    char* target = map_huge(bytes);
+    if (!target)
+        return NULL;
+    if (mremap(data, old_bytes, old_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, target) == MAP_FAILED) {
+        munmap(target, bytes);
+        return NULL;
+    }
+
+    return target;
+}
+#endif
+
+// moves content of own buffer to new buffer of given capacity, on failure nothing is changed
+static int move_buffer(my_str_t* str, size_t capacity) {
+    char* data;
+    if (capacity > MAX_CAPACITY)
+        return MEMORY_ALLOCATION_ERR;
+#ifdef __linux__
+    if (str->capacity_m >= MY_STR_HUGE_MIN && capacity >= MY_STR_HUGE_MIN) {
+        data = remap_huge(str->data, huge_size(str->capacity_m), huge_size(capacity));
+        if (!data)
+            return MEMORY_ALLOCATION_ERR;
+
+        // after shrinking old content may be in the padding
+        memset(data + capacity + 1, 0, MY_STR_PADDING);
+        str->data = data;
+        str->capacity_m = capacity;
+        return 0;
+    }
+#endif
+
+    data = alloc_buffer(capacity);
+    if (!data)
+        return MEMORY_ALLOCATION_ERR;
+
+    if (str->size_m)
+        memcpy(data, str->data, str->size_m);
+    free_buffer(str->data, str->capacity_m);
+    str->data = data;
+    str->capacity_m = capacity;
+
+    return 0;
+}
+
+// returns position of the first c in data[from, size) or size if there is none;
+// whole blocks are read past size, the padding of buffers makes it safe
+static size_t find_byte(const char* data, size_t from, size_t size, char c) {
+#ifdef __SSE2__
+    const __m128i needle = _mm_set1_epi8(c);
+    for (size_t i = from; i < size; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *) (data + i));
+        unsigned mask = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask) {
+            size_t pos = i + lowest_bit(mask);
+            return (pos < size) ? pos : size;
+        }
+    }
+#else
+    // word at a time: word ^ pattern has zero byte where c is
+    const uint64_t ones = 0x0101010101010101ULL, highs = 0x8080808080808080ULL;
+    const uint64_t pattern = ones * (unsigned char) c;
+    for (size_t i = from; i < size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        word ^= pattern;
+        if (!((word - ones) & ~word & highs))
+            continue;
+        for (size_t j = i; j < i + 8 && j < size; j++)
+            if (data[j] == c)
+                return j;
+    }
+#endif
+    return size;
+}
+
+#ifdef __SSE2__
+static unsigned lowest_bit(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned) __builtin_ctz(mask);
+#else
+    unsigned i = 0;
+    for (; !(mask & 1u); mask >>= 1)
+        i++;
+    return i;
+#endif
+}
+#endif
@@ -19,13 +19,57 @@
 #define ARR_LEN(a) sizeof(a)/sizeof(a[0])
 #define BUF_SIZE 4096
 #define FORMAT_SIZE 32
-
+#define READ_CHUNK_SIZE (1 << 16) // size of single read(2) call for descriptor reads
+#define MY_STR_SHARE_MIN 64 // shorter substrings are copied by my_str_substr_shared
+#define MY_STR_COMPACT_RATIO 16 // my_str_compact copies slices smaller than 1/16 of the buffer
+#define MY_STR_ALIGN 64 // own buffers of my_str-strings begin at this boundary (cache line)
+#define MY_STR_PADDING 64 // zero bytes after data[capacity_m] of own buffers, at least one vector
+#define MY_STR_HUGE_MIN ((size_t) 1 << 25) // buffers of at least 32 MiB are mapped on huge pages
+#define MY_STR_HUGE_PAGE ((size_t) 1 << 21) // huge page size, mapped buffers are aligned to it
+
+// buffer shared by my_str_substr_shared, freed together with the last string that uses it
+typedef struct {
+    size_t refs;       // Number of strings that point into the buffer, changed atomically
+    char *data;        // Beginning of the buffer
+    size_t capacity_m; // Block size of the buffer
+    size_t size_m;     // Size of content when buffer became shared, next byte is free for '\0'
+} my_str_shared_t;
+
+// own buffer is MY_STR_ALIGN aligned and followed by MY_STR_PADDING readable bytes, so search
+// kernels load whole vectors past size_m without checking tails or page boundaries;
+// substrings point into such buffers, so they keep the padding but not the alignment;
+// buffers with capacity of at least MY_STR_HUGE_MIN are mmap-ed, aligned to MY_STR_HUGE_PAGE
+// and advised to use transparent huge pages, so long scans make less TLB misses
 typedef struct {
     size_t capacity_m; // Block size
     size_t size_m;     // Actual size of the string
     char *data;       // Pointer on data block
+    uint64_t hash_m;  // Cached my_str_hash with seed 0, 0 if not computed yet
+    my_str_shared_t *shared; // NULL if data is own, else data points into shared buffer
 } my_str_t;
 
+// automatic shrinking of buffers after my_str_erase, my_str_popback and my_str_resize (my_str_clear keeps
+// the buffer for refilling, my_str_shrink_to_fit releases it explicitly);
+// capacity after shrinking stays bigger than size * factor, so it shrinks again or grows only
+// after size changes at least twice (hysteresis) and alternating edits never reallocate
+typedef struct {
+    size_t trigger;      // buffer shrinks when size * trigger < capacity, 0 - never (default)
+    size_t factor;       // new capacity is size * factor, should be smaller than trigger
+    size_t min_capacity; // buffers are never shrunk below this capacity
+} my_str_shrink_policy_t;
+
+// non-owning reference to a part of my_str-string or any other memory, not null terminated
+typedef struct {
+    const char *data; // Pointer on first symbol
+    size_t size_m;    // Size of the referenced part
+} my_str_view_t;
+
+// writes at most max_size bytes of new content to data and returns its size
+typedef size_t (*my_str_overwrite_callback)(char* data, size_t max_size, void* arg);
+
+// receives chunks of data in incremental reads, non zero return stops reading
+typedef int (*my_str_chunk_callback)(const char* chunk, size_t size, void* arg);
+
 /*
  * Creates empty dynamic string (my_str_t)
  * !important! user should always use my_str_create before using ANY other function
@@ -75,6 +119,19 @@ size_t my_str_capacity(const my_str_t* str);
  */
 int my_str_empty(const my_str_t* str);
 
+/*
+ * returns view of the whole content of my_str-string
+ * view is invalidated by any change of the string
+ * if str == NULL than view is empty
+ */
+my_str_view_t my_str_view(const my_str_t* str);
+
+/*
+ * returns view of given c-string (without terminating zero)
+ * if cstr == NULL than view is empty
+ */
+my_str_view_t my_str_view_cstr(const char* cstr);
+
 /*
  * returns symbol on given index in my_str-string
  * return:
@@ -113,7 +170,9 @@ int my_str_copy(const my_str_t* from,  my_str_t* to, int reserve);
 /*
  *  clears content of string, does nothing if string is NULL
  *  return:
- *      always 0
+ *      0  if OK
+ *      MEMORY_ALLOCATION_ERR if string shared its buffer and there was an error during
+ *      allocation of own one, string is left empty without buffer then
  */
 int my_str_clear(my_str_t* str);
 
@@ -181,6 +240,32 @@ int my_str_append_c(my_str_t* str, char c);
  */
 int my_str_substr(const my_str_t* from, my_str_t* to, size_t beg, size_t end);
 
+/*
+ * makes given my_str-string a substring of from in given bounds without copying:
+ * both strings point into one refcounted buffer, and any of them is copied only when
+ * it is changed; substrings shorter than MY_STR_SHARE_MIN are just copied
+ * to must be created and differ from from
+ * reference count is atomic (with GCC and Clang), so strings sharing a buffer may be used by
+ * different threads; one string still must not be used by several threads at once
+ * return:
+ *      0  if oK
+ *      NULL_PTR_ERR if from or to is NULL
+ *      RANGE_ERR if boundaries are bad or from == to
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_substr_shared(my_str_t* from, my_str_t* to, size_t beg, size_t end);
+
+/*
+ * copies shared substring into own buffer if it is smaller than 1/MY_STR_COMPACT_RATIO of
+ * the buffer it points into, so tiny substrings do not keep huge buffers alive;
+ * does nothing for other strings
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_compact(my_str_t* str);
+
 /*
  * saves my_str-string substring in given bounds to given c-string
  * !important! given c-string should be big enough
@@ -216,6 +301,7 @@ int my_str_popback(my_str_t* str);
 /*
  * increases given my_str-string's buffer to given value.
  * if buf_size < my_str-string capacity, does nothing
+ * new buffer is aligned and padded, as described at my_str_t
  * return:
  *      0  if OK
  *      NULL_PTR_ERR if str is NULL
@@ -223,8 +309,44 @@ int my_str_popback(my_str_t* str);
  */
 int my_str_reserve(my_str_t* str, size_t buf_size);
 
+/*
+ * makes place for at least extra bytes after the content without initializing them,
+ * so producers (read, decoders, formatters) can write there directly;
+ * written bytes become part of the string after my_str_commit
+ * buffer grows at least twice if it grows
+ * spare: pointer to the first byte after the content is saved there
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str or spare is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_reserve_uninit(my_str_t* str, size_t extra, char** spare);
+
+/*
+ * appends written bytes that are already in the buffer after the content
+ * (usually after my_str_reserve_uninit) to the string
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ *      RANGE_ERR if written is bigger than free space of the buffer
+ */
+int my_str_commit(my_str_t* str, size_t written);
+
+/*
+ * replaces content of the string by what callback writes directly into the buffer:
+ * callback gets buffer with max_size bytes, where old content is kept but the rest is not
+ * initialized, and returns new size
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str or callback is NULL
+ *      RANGE_ERR if callback returned size bigger than max_size, string is empty then
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_resize_and_overwrite(my_str_t* str, size_t max_size, my_str_overwrite_callback callback, void* arg);
+
 /*
  * decreases buffer of given my_str-string to size of string
+ * new buffer is aligned and padded, as described at my_str_t
  * return:
  *      0  if OK
  *      NULL_PTR_ERR if from ot str is NULL
@@ -232,6 +354,19 @@ int my_str_reserve(my_str_t* str, size_t buf_size);
  */
 int my_str_shrink_to_fit(my_str_t* str);
 
+/*
+ * sets shrink policy for all my_str-strings, should be set before strings are used by threads
+ * return:
+ *      0  if OK
+ *      RANGE_ERR if trigger is not 0 and factor is 0 or not smaller than trigger
+ */
+int my_str_set_shrink_policy(my_str_shrink_policy_t policy);
+
+/*
+ * returns current shrink policy
+ */
+my_str_shrink_policy_t my_str_get_shrink_policy(void);
+
 /*
  * resizes my_str-string to given size.
  * if given size > size of string than filles next bytes with given chars
@@ -251,9 +386,71 @@ int my_str_resize(my_str_t* str, size_t new_size, char sym);
  *      MEMORY_ALLOCATION_ERR if there was an error during allocating memory for buffer
  */
 
-/* ???????????????????????????????????????????? */
+/*
+ * returns position of the first occurrence of tofind in my_str-string, starting from given position
+ * errors are cast to size_t, so my_str_find_pos should be used when they must be told apart
+ * return:
+ *      position of tofind if it is in string
+ *      (size_t) NOT_FOUND_CODE if it's not in string, empty tofind is never found
+ *      (size_t) NULL_PTR_ERR if str or tofind is NULL
+ */
 size_t my_str_find(const my_str_t* str, const my_str_t* tofind, size_t from);
 
+/*
+ * finds the first occurrence of tofind in my_str-string starting from given position and
+ * writes its position to pos; positions are size_t, so strings of any size are searched
+ * return:
+ *      0  if found
+ *      NOT_FOUND_CODE if it's not in string, empty tofind is never found
+ *      NULL_PTR_ERR if str, tofind or pos is NULL
+ */
+int my_str_find_pos(const my_str_t* str, const my_str_t* tofind, size_t from, size_t* pos);
+
+/*
+ * returns 64-bit hash of given bytes (wyhash), equal content and seed always give equal hash
+ * seed: allows to get independent hash functions, e.g. for per-process randomization
+ * if data == NULL than hash of empty data is returned
+ */
+uint64_t my_str_hash_bytes(const void* data, size_t size, uint64_t seed);
+
+/*
+ * returns 64-bit hash of my_str-string content, the same as my_str_hash_bytes over its data
+ * if str == NULL than hash of empty string is returned
+ */
+uint64_t my_str_hash(const my_str_t* str, uint64_t seed);
+
+/*
+ * returns 64-bit hash of the viewed content, the same as my_str_hash_bytes over its data
+ */
+uint64_t my_str_hash_view(my_str_view_t view, uint64_t seed);
+
+/*
+ * returns my_str_hash with seed 0 and remembers it in the string, so repeated calls
+ * do not rehash; all functions that change the string forget remembered hash
+ * !important! if data of the string is changed directly, my_str_hash_invalidate should be called
+ * if str == NULL than hash of empty string is returned
+ */
+uint64_t my_str_hash_cached(my_str_t* str);
+
+/*
+ * forgets hash remembered by my_str_hash_cached
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ */
+int my_str_hash_invalidate(my_str_t* str);
+
+/*
+ * checks whether two my_str-strings have the same content
+ * if hashes of both strings are remembered, strings with different hashes are rejected
+ * without looking at their content
+ * return:
+ *      1 if str1 == str2
+ *      0 if str1 != str2
+ *      NULL_PTR_ERR if str1 or str2 is NULL
+ */
+int my_str_equal(const my_str_t* str1, const my_str_t* str2);
+
 /*
  * compares two my_str-strings like conventional c-strings (in lexicographical order)
  * return:
@@ -277,18 +474,39 @@ int my_str_cmp_cstr(const my_str_t* str1, const char* cstr2);
  *      position of char symbol if its in string
  *      NOT_FOUND_CODE if it's not in string
  *      NULL_PTR_ERR if str is NULL
+ *      RANGE_ERR if position does not fit in int, my_str_find_c_pos works for such strings
  */
 int my_str_find_c(const my_str_t* str, char tofind, size_t from);
 
+/*
+ * finds given symbol (including '\0') in my_str-string starting from given position
+ * and writes its position to pos
+ * return:
+ *      0  if found
+ *      NOT_FOUND_CODE if it's not in string
+ *      NULL_PTR_ERR if str or pos is NULL
+ */
+int my_str_find_c_pos(const my_str_t* str, char tofind, size_t from, size_t* pos);
+
 /*
  * returns position of symbol that predicate on ot returns 1, if there is no symbol like that than -1
  * return:
  *      position of char symbol that satisfies predicate
  *      NOT_FOUND_CODE if it's not in string
  *      NULL_PTR_ERR if str or predicate is NULL
+ *      RANGE_ERR if position does not fit in int, my_str_find_if_pos works for such strings
  */
 int my_str_find_if(const my_str_t* str, size_t beg, int (*predicat)(int));
 
+/*
+ * finds symbol that predicate on it returns 1 starting from beg and writes its position to pos
+ * return:
+ *      0  if found
+ *      NOT_FOUND_CODE if it's not in string
+ *      NULL_PTR_ERR if str, predicate or pos is NULL
+ */
+int my_str_find_if_pos(const my_str_t* str, size_t beg, int (*predicat)(int), size_t* pos);
+
 /*
  * reads file and saves it's content into given my_str-string
  * resizes string's buffer if needed
@@ -301,6 +519,9 @@ int my_str_read_file(my_str_t* str, FILE* file);
 
 /*
  * reads content from stdin and saves to my_str-string
+ * if stdio did not buffer anything from stdin yet, it is read by my_str_read_fd with large read(2)
+ * calls; otherwise (or if C library does not let us check it) stdio is used, so that already
+ * buffered bytes are not lost
  * return:
  *      0  if OK
  *      NULL_PTR_ERR if str is NULL
@@ -309,6 +530,33 @@ int my_str_read_file(my_str_t* str, FILE* file);
  */
 int my_str_read(my_str_t* str);
 
+/*
+ * reads everything from given file descriptor (usually pipe or stdin) up to EOF into my_str-string
+ * uses large read(2) calls directly into the string buffer, which grows geometrically
+ * size_hint: expected number of bytes, buffer is reserved for it up front; if 0 and fd is a
+ * regular file, rest of the file size is used as a hint
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during increasing buffer
+ *      IO_READ_ERR if fd is bad or there was error while reading
+ */
+int my_str_read_fd(my_str_t* str, int fd, size_t size_hint);
+
+/*
+ * reads given file descriptor up to EOF and hands every chunk to callback as soon as it arrives
+ * nothing is accumulated, chunk is valid only during the callback call
+ * chunk_size: size of read buffer, if 0 then READ_CHUNK_SIZE is used
+ * callback: is called with chunk, its size and given arg; non zero return stops reading
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if callback is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during allocating read buffer
+ *      IO_READ_ERR if fd is bad or there was error while reading
+ *      else - non zero value returned by callback
+ */
+int my_str_read_fd_chunks(int fd, size_t chunk_size, my_str_chunk_callback callback, void* arg);
+
 /*
  * reads file and saves it's content into my_str-string, stops when reached delimiter or EOF
  * return:
@@ -336,7 +584,30 @@ int my_str_write_file(const my_str_t* str, FILE* file);
  */
 int my_str_write(const my_str_t* str);
 
-static size_t length_cstr(const char * str);
+/*
+ * writes content of given my_str-string to given file descriptor (file, pipe or socket)
+ * without going through stdio buffers; retries on partial writes and EINTR
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if str is NULL
+ *      IO_WRITE_ERR if fd is bad or error occurred while writing
+ */
+int my_str_write_fd(const my_str_t* str, int fd);
+
+/*
+ * transfers count bytes (or everything up to EOF if count == SIZE_MAX) from the current
+ * position of given file to given file descriptor without copying them into a my_str-string.
+ * on linux the data is moved by the kernel (copy_file_range for file to file, sendfile for
+ * file to pipe or socket), otherwise or if kernel refuses, plain read/write loop is used.
+ * position of file is advanced by the number of transferred bytes
+ * transferred: if not NULL, number of transferred bytes is saved there
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if from is NULL
+ *      IO_READ_ERR if error occurred while reading
+ *      IO_WRITE_ERR if fd is bad or error occurred while writing
+ */
+int my_str_transfer_file(FILE* from, int fd, size_t count, size_t* transferred);
 
 #endif // C_STRINGS_H
 
@@ -0,0 +1,509 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_approx.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#define HIGH_BIT ((uint64_t) 1 << 63)
+#define STACK_BLOCKS 8 // vertical deltas of patterns up to 512 bytes are kept on stack
+
+// the first match found by my_str_approx_find
+typedef struct {
+    size_t end;
+    size_t cost;
+} first_match_t;
+
+// state shared by threads of my_str_edit_distance_batch
+typedef struct {
+    const my_str_approx_t* query;
+    const my_str_t* strs;
+    size_t count;
+    size_t max;
+    size_t* distances;
+    size_t next;
+    int err;
+    pthread_mutex_t lock;
+} batch_t;
+
+static int block_step(uint64_t* pv, uint64_t* mv, uint64_t eq, int hin, uint64_t out_bit);
+static int save_first(size_t end, size_t cost, void* arg);
+static int distance_to(const my_str_approx_t* approx, my_str_view_t text, size_t max, size_t* distance);
+static size_t global_distance(const my_str_approx_t* approx, my_str_view_t text, size_t max, uint64_t* deltas);
+static void* batch_worker(void* arg);
+
+/*
+ * prepares pattern of any size for approximate search
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if approx is NULL or pattern has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_approx_create(my_str_approx_t* approx, my_str_view_t pattern) {
+    if (!approx || (!pattern.data && pattern.size_m))
+        return NULL_PTR_ERR;
+
+    approx->size_m = pattern.size_m;
+    approx->blocks = pattern.size_m / 64 + (pattern.size_m % 64 != 0);
+    approx->peq = (uint64_t *) calloc(256 * approx->blocks + 1, sizeof(uint64_t));
+    if (!approx->peq)
+        return MEMORY_ALLOCATION_ERR;
+
+    for (size_t i = 0; i < pattern.size_m; i++) {
+        unsigned char c = (unsigned char) pattern.data[i];
+        approx->peq[c * approx->blocks + i / 64] |= (uint64_t) 1 << (i % 64);
+    }
+
+    return 0;
+}
+
+/*
+ * frees all data of prepared pattern
+ * return:
+ *     0 always
+ */
+int my_str_approx_free(my_str_approx_t* approx) {
+    if (!approx)
+        return 0;
+
+    free(approx->peq);
+    approx->peq = NULL;
+    approx->blocks = approx->size_m = 0;
+
+    return 0;
+}
+
+/*
+ * reports every end of text substring that differs from the pattern by at most k edits
+ * (insertions, deletions and substitutions of single bytes) with the smallest number of edits
+ * for such end; ends go in increasing order, empty pattern never matches
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if approx or callback is NULL or text has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ *      else - non zero value returned by callback, rest of text is not searched
+ */
+int my_str_approx_search(const my_str_approx_t* approx, my_str_view_t text, size_t k,
+                         my_str_approx_callback callback, void* arg) {
+    if (!approx || !approx->peq || !callback || (!text.data && text.size_m))
+        return NULL_PTR_ERR;
+
+    if (!approx->size_m)
+        return 0;
+
+    // column of the distance matrix is kept as vertical deltas, +1 (pv) or -1 (mv) for every row
+    size_t blocks = approx->blocks;
+    uint64_t stack_deltas[2 * STACK_BLOCKS];
+    uint64_t* pv = stack_deltas;
+    if (blocks > STACK_BLOCKS) {
+        pv = (uint64_t *) malloc(2 * blocks * sizeof(uint64_t));
+        if (!pv)
+            return MEMORY_ALLOCATION_ERR;
+    }
+    uint64_t* mv = pv + blocks;
+    for (size_t b = 0; b < blocks; b++) {
+        pv[b] = ~(uint64_t) 0;
+        mv[b] = 0;
+    }
+
+    // the last row of the pattern may be in the middle of the last block
+    uint64_t last_bit = (uint64_t) 1 << ((approx->size_m - 1) % 64);
+    size_t score = approx->size_m;
+    int err = 0;
+
+    for (size_t j = 0; j < text.size_m && err == 0; j++) {
+        const uint64_t* eq = approx->peq + (unsigned char) text.data[j] * blocks;
+
+        // match may start anywhere, so the top row is 0 and nothing comes from above
+        int hin = 0;
+        for (size_t b = 0; b + 1 < blocks; b++)
+            hin = block_step(&pv[b], &mv[b], eq[b], hin, HIGH_BIT);
+        int delta = block_step(&pv[blocks - 1], &mv[blocks - 1], eq[blocks - 1], hin, last_bit);
+        if (delta > 0)
+            score++;
+        else if (delta < 0)
+            score--;
+
+        if (score <= k)
+            err = callback(j + 1, score, arg);
+    }
+
+    if (pv != stack_deltas)
+        free(pv);
+
+    return err;
+}
+
+/*
+ * finds the first end of substring that differs from the pattern by at most k edits
+ * end, cost: end of the match and its number of edits are saved there
+ * return:
+ *      0  if OK
+ *      NOT_FOUND_CODE if there is no such substring
+ *      NULL_PTR_ERR if str, end or cost is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_approx_find(const my_str_t* str, my_str_view_t pattern, size_t k, size_t* end, size_t* cost) {
+    if (!str || !end || !cost)
+        return NULL_PTR_ERR;
+
+    my_str_approx_t approx;
+    int err = my_str_approx_create(&approx, pattern);
+    if (err != 0) return err;
+
+    first_match_t match = {0, 0};
+    err = my_str_approx_search(&approx, my_str_view(str), k, save_first, &match);
+    my_str_approx_free(&approx);
+
+    // save_first stops the search with 1
+    if (err == 1) {
+        *end = match.end;
+        *cost = match.cost;
+        return 0;
+    }
+
+    return (err == 0) ? NOT_FOUND_CODE : err;
+}
+
+/*
+ * computes Levenshtein distance (insertions, deletions and substitutions of single bytes)
+ * with bit-parallel Myers algorithm in O(n * m / 64)
+ * max: computing stops as soon as distance is known to be greater, SIZE_MAX for no limit
+ * distance: exact distance is saved there if it is not greater than max, else max + 1
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if a, b or distance is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edit_distance(const my_str_t* a, const my_str_t* b, size_t max, size_t* distance) {
+    if (!a || !b || !distance)
+        return NULL_PTR_ERR;
+
+    // the shorter string is the pattern, so there are less blocks
+    const my_str_t* pattern = (a->size_m <= b->size_m) ? a : b;
+    const my_str_t* text = (pattern == a) ? b : a;
+
+    if (pattern->size_m > 64) {
+        my_str_approx_t approx;
+        int err = my_str_approx_create(&approx, my_str_view(pattern));
+        if (err != 0) return err;
+        err = distance_to(&approx, my_str_view(text), max, distance);
+        my_str_approx_free(&approx);
+        return err;
+    }
+
+    // a single block is prepared on stack, without allocations
+    uint64_t peq[256];
+    memset(peq, 0, sizeof(peq));
+    for (size_t i = 0; i < pattern->size_m; i++)
+        peq[(unsigned char) pattern->data[i]] |= (uint64_t) 1 << i;
+
+    my_str_approx_t approx = {peq, 1, pattern->size_m};
+    return distance_to(&approx, my_str_view(text), max, distance);
+}
+
+/*
+ * computes edit distance only in the band of cells not further than band from the diagonal,
+ * in O(n * band); it is exact if it is not greater than band
+ * distance: exact distance is saved there if it is not greater than band, else band + 1
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if a, b or distance is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edit_distance_banded(const my_str_t* a, const my_str_t* b, size_t band, size_t* distance) {
+    if (!a || !b || !distance)
+        return NULL_PTR_ERR;
+
+    size_t m = a->size_m, n = b->size_m;
+    size_t longer = (m > n) ? m : n;
+    size_t diff = (m > n) ? m - n : n - m;
+    if (diff > band) {
+        *distance = band + 1;
+        return 0;
+    }
+
+    // distance is never greater than the longer size, so wider band changes nothing
+    size_t w = (band < longer) ? band : longer;
+    size_t width = 2 * w + 1;
+    size_t inf = w + 1;
+    size_t* prev = (size_t *) malloc(2 * width * sizeof(size_t));
+    if (!prev)
+        return MEMORY_ALLOCATION_ERR;
+    size_t* cur = prev + width;
+
+    // cell of row i and column j is kept at j - i + w
+    for (size_t k = 0; k < width; k++)
+        prev[k] = (k >= w && k - w <= n) ? k - w : inf;
+
+    size_t result = inf;
+    int early = 0;
+    for (size_t i = 1; i <= m && !early; i++) {
+        size_t row_min = inf;
+        for (size_t k = 0; k < width; k++) {
+            if (i + k < w || i + k - w > n) {
+                cur[k] = inf;
+                continue;
+            }
+
+            size_t j = i + k - w;
+            size_t value;
+            if (j == 0) {
+                value = i;
+            } else {
+                value = prev[k] + (a->data[i - 1] != b->data[j - 1]);
+                if (k + 1 < width && prev[k + 1] + 1 < value)
+                    value = prev[k + 1] + 1;
+                if (k > 0 && cur[k - 1] + 1 < value)
+                    value = cur[k - 1] + 1;
+            }
+
+            cur[k] = (value < inf) ? value : inf;
+            if (cur[k] < row_min)
+                row_min = cur[k];
+        }
+
+        // distance can not be smaller than the smallest value of any row
+        early = row_min > w;
+
+        size_t* t = prev;
+        prev = cur;
+        cur = t;
+    }
+
+    if (!early)
+        result = prev[n + w - m];
+    free((prev < cur) ? prev : cur);
+
+    *distance = (result <= band) ? result : band + 1;
+    return 0;
+}
+
+/*
+ * computes number of positions where strings of equal size have different bytes
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if a, b or distance is NULL
+ *      RANGE_ERR if strings have different sizes
+ */
+int my_str_hamming(const my_str_t* a, const my_str_t* b, size_t* distance) {
+    if (!a || !b || !distance)
+        return NULL_PTR_ERR;
+
+    if (a->size_m != b->size_m)
+        return RANGE_ERR;
+
+    size_t diff = 0, i = 0;
+    // eight bytes are compared at once, the lowest bit of every byte tells whether they differ
+    for (; i + 8 <= a->size_m; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a->data + i, 8);
+        memcpy(&y, b->data + i, 8);
+        uint64_t v = x ^ y;
+        v |= v >> 4;
+        v |= v >> 2;
+        v |= v >> 1;
+        v &= 0x0101010101010101ull;
+        diff += (size_t) ((v * 0x0101010101010101ull) >> 56);
+    }
+    for (; i < a->size_m; i++)
+        diff += (a->data[i] != b->data[i]);
+
+    *distance = diff;
+    return 0;
+}
+
+/*
+ * computes similarity 1 - distance / (size of longer string), 1 for equal strings and 0 for
+ * strings that have nothing in common
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if a, b or similarity is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_similarity(const my_str_t* a, const my_str_t* b, double* similarity) {
+    if (!a || !b || !similarity)
+        return NULL_PTR_ERR;
+
+    size_t longer = (a->size_m > b->size_m) ? a->size_m : b->size_m;
+    size_t distance = 0;
+    int err = my_str_edit_distance(a, b, SIZE_MAX, &distance);
+    if (err != 0) return err;
+
+    *similarity = longer ? 1.0 - (double) distance / (double) longer : 1.0;
+    return 0;
+}
+
+/*
+ * computes edit distances between the query and every string of array, query is prepared once
+ * and strings are divided between threads
+ * max: the same as in my_str_edit_distance
+ * distances: array of count elements, distances[i] is the distance to strs[i]
+ * threads: number of threads including the calling one, 0 - number of CPUs
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if query or distances is NULL, or strs is NULL and count is not 0
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edit_distance_batch(const my_str_t* query, const my_str_t* strs, size_t count, size_t max,
+                               size_t* distances, size_t threads) {
+    if (!query || (!distances && count) || (!strs && count))
+        return NULL_PTR_ERR;
+
+    if (!count)
+        return 0;
+
+    my_str_approx_t approx;
+    int err = my_str_approx_create(&approx, my_str_view(query));
+    if (err != 0) return err;
+
+    batch_t batch;
+    batch.query = &approx;
+    batch.strs = strs;
+    batch.count = count;
+    batch.max = max;
+    batch.distances = distances;
+    batch.next = 0;
+    batch.err = 0;
+    if (pthread_mutex_init(&batch.lock, NULL) != 0) {
+        my_str_approx_free(&approx);
+        return MEMORY_ALLOCATION_ERR;
+    }
+
+    if (!threads) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 1) ? (size_t) cpus : 1;
+    }
+    size_t steps = (count + MY_STR_BATCH_STEP - 1) / MY_STR_BATCH_STEP;
+    threads = (threads < steps) ? threads : steps;
+
+    // the calling thread is one of the workers
+    pthread_t* workers = (threads > 1) ? (pthread_t *) malloc((threads - 1) * sizeof(pthread_t)) : NULL;
+    size_t started = 0;
+    for (; workers && started < threads - 1; started++)
+        if (pthread_create(&workers[started], NULL, batch_worker, &batch) != 0)
+            break;
+
+    batch_worker(&batch);
+    for (size_t i = 0; i < started; i++)
+        pthread_join(workers[i], NULL);
+
+    free(workers);
+    pthread_mutex_destroy(&batch.lock);
+    my_str_approx_free(&approx);
+    return batch.err;
+}
+
+/*
+ * one column step of Myers algorithm for 64 rows (Hyyro's block formulation)
+ * hin: horizontal delta that comes into the top row of the block, -1, 0 or +1
+ * return: horizontal delta at the row of out_bit
+ */
+static int block_step(uint64_t* pv, uint64_t* mv, uint64_t eq, int hin, uint64_t out_bit) {
+    uint64_t pv_in = *pv, mv_in = *mv;
+    uint64_t hin_neg = (hin < 0), hin_pos = (hin > 0);
+
+    uint64_t xv = eq | mv_in;
+    eq |= hin_neg;
+    uint64_t xh = (((eq & pv_in) + pv_in) ^ pv_in) | eq;
+    uint64_t ph = mv_in | ~(xh | pv_in);
+    uint64_t mh = pv_in & xh;
+
+    int hout = (ph & out_bit) ? 1 : ((mh & out_bit) ? -1 : 0);
+
+    ph = (ph << 1) | hin_pos;
+    mh = (mh << 1) | hin_neg;
+    *pv = mh | ~(xv | ph);
+    *mv = ph & xv;
+
+    return hout;
+}
+
+static int save_first(size_t end, size_t cost, void* arg) {
+    first_match_t* match = (first_match_t *) arg;
+    match->end = end;
+    match->cost = cost;
+    return 1;
+}
+
+static int distance_to(const my_str_approx_t* approx, my_str_view_t text, size_t max, size_t* distance) {
+    uint64_t stack_deltas[2 * STACK_BLOCKS];
+    uint64_t* deltas = stack_deltas;
+    if (approx->blocks > STACK_BLOCKS) {
+        deltas = (uint64_t *) malloc(2 * approx->blocks * sizeof(uint64_t));
+        if (!deltas)
+            return MEMORY_ALLOCATION_ERR;
+    }
+
+    *distance = global_distance(approx, text, max, deltas);
+
+    if (deltas != stack_deltas)
+        free(deltas);
+    return 0;
+}
+
+// Myers algorithm for the whole pattern against the whole text, max + 1 if distance is larger
+static size_t global_distance(const my_str_approx_t* approx, my_str_view_t text, size_t max, uint64_t* deltas) {
+    size_t m = approx->size_m, n = text.size_m;
+    size_t diff = (m > n) ? m - n : n - m;
+    if (diff > max)
+        return max + 1;
+    if (!m || !n)
+        return diff;
+
+    size_t blocks = approx->blocks;
+    uint64_t* pv = deltas;
+    uint64_t* mv = deltas + blocks;
+    for (size_t b = 0; b < blocks; b++) {
+        pv[b] = ~(uint64_t) 0;
+        mv[b] = 0;
+    }
+
+    uint64_t last_bit = (uint64_t) 1 << ((m - 1) % 64);
+    size_t score = m;
+    for (size_t j = 0; j < n; j++) {
+        const uint64_t* eq = approx->peq + (unsigned char) text.data[j] * blocks;
+
+        // the top row grows by one in every column
+        int hin = 1;
+        for (size_t b = 0; b + 1 < blocks; b++)
+            hin = block_step(&pv[b], &mv[b], eq[b], hin, HIGH_BIT);
+        int delta = block_step(&pv[blocks - 1], &mv[blocks - 1], eq[blocks - 1], hin, last_bit);
+        if (delta > 0)
+            score++;
+        else if (delta < 0)
+            score--;
+
+        // every remaining column decreases the last row by one at most
+        size_t remaining = n - j - 1;
+        if (score > remaining && score - remaining > max)
+            return max + 1;
+    }
+
+    return score;
+}
+
+static void* batch_worker(void* arg) {
+    batch_t* batch = (batch_t *) arg;
+
+    for (;;) {
+        pthread_mutex_lock(&batch->lock);
+        size_t start = batch->next;
+        batch->next += MY_STR_BATCH_STEP;
+        pthread_mutex_unlock(&batch->lock);
+        if (start >= batch->count)
+            break;
+
+        size_t end = (batch->count - start < MY_STR_BATCH_STEP) ? batch->count : start + MY_STR_BATCH_STEP;
+        for (size_t i = start; i < end; i++) {
+            int err = distance_to(batch->query, my_str_view(&batch->strs[i]), batch->max, &batch->distances[i]);
+            if (err != 0) {
+                pthread_mutex_lock(&batch->lock);
+                batch->err = err;
+                pthread_mutex_unlock(&batch->lock);
+            }
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,119 @@
+#pragma once
+#ifndef C_STRING_APPROX_H
+#define C_STRING_APPROX_H
+
+#include "c_string.h"
+
+#define MY_STR_BATCH_STEP 64 // strings taken by a thread of my_str_edit_distance_batch at once
+
+// receives end (position after the last symbol) and edit distance of every approximate match,
+// non zero return stops the search
+typedef int (*my_str_approx_callback)(size_t end, size_t cost, void* arg);
+
+/*
+ * pattern prepared for bit-parallel search (Myers algorithm), one bit for every pattern symbol,
+ * so every text symbol is processed in O(m / 64) word operations
+ */
+typedef struct {
+    uint64_t *peq;    // peq[c * blocks + b] - bits of positions in block b where pattern has byte c
+    size_t blocks;    // number of 64-bit blocks of the pattern
+    size_t size_m;    // size of the pattern
+} my_str_approx_t;
+
+/*
+ * prepares pattern of any size for approximate search
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if approx is NULL or pattern has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_approx_create(my_str_approx_t* approx, my_str_view_t pattern);
+
+/*
+ * frees all data of prepared pattern
+ * return:
+ *     0 always
+ */
+int my_str_approx_free(my_str_approx_t* approx);
+
+/*
+ * reports every end of text substring that differs from the pattern by at most k edits
+ * (insertions, deletions and substitutions of single bytes) with the smallest number of edits
+ * for such end; ends go in increasing order, empty pattern never matches
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if approx or callback is NULL or text has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ *      else - non zero value returned by callback, rest of text is not searched
+ */
+int my_str_approx_search(const my_str_approx_t* approx, my_str_view_t text, size_t k,
+                         my_str_approx_callback callback, void* arg);
+
+/*
+ * finds the first end of substring that differs from the pattern by at most k edits
+ * end, cost: end of the match and its number of edits are saved there
+ * return:
+ *      0  if OK
+ *      NOT_FOUND_CODE if there is no such substring
+ *      NULL_PTR_ERR if str, end or cost is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_approx_find(const my_str_t* str, my_str_view_t pattern, size_t k, size_t* end, size_t* cost);
+
+/*
+ * computes Levenshtein distance (insertions, deletions and substitutions of single bytes)
+ * with bit-parallel Myers algorithm in O(n * m / 64)
+ * max: computing stops as soon as distance is known to be greater, SIZE_MAX for no limit
+ * distance: exact distance is saved there if it is not greater than max, else max + 1
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if a, b or distance is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edit_distance(const my_str_t* a, const my_str_t* b, size_t max, size_t* distance);
+
+/*
+ * computes edit distance only in the band of cells not further than band from the diagonal,
+ * in O(n * band); it is exact if it is not greater than band
+ * distance: exact distance is saved there if it is not greater than band, else band + 1
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if a, b or distance is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edit_distance_banded(const my_str_t* a, const my_str_t* b, size_t band, size_t* distance);
+
+/*
+ * computes number of positions where strings of equal size have different bytes
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if a, b or distance is NULL
+ *      RANGE_ERR if strings have different sizes
+ */
+int my_str_hamming(const my_str_t* a, const my_str_t* b, size_t* distance);
+
+/*
+ * computes similarity 1 - distance / (size of longer string), 1 for equal strings and 0 for
+ * strings that have nothing in common
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if a, b or similarity is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_similarity(const my_str_t* a, const my_str_t* b, double* similarity);
+
+/*
+ * computes edit distances between the query and every string of array, query is prepared once
+ * and strings are divided between threads
+ * max: the same as in my_str_edit_distance
+ * distances: array of count elements, distances[i] is the distance to strs[i]
+ * threads: number of threads including the calling one, 0 - number of CPUs
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if query or distances is NULL, or strs is NULL and count is not 0
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edit_distance_batch(const my_str_t* query, const my_str_t* strs, size_t count, size_t max,
+                               size_t* distances, size_t threads);
+
+#endif // C_STRING_APPROX_H
@@ -0,0 +1,196 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_chunk_reader.h"
+
+#include <unistd.h>
+
+static void* reader_thread(void* arg);
+static void free_slots(my_str_chunk_reader_t* reader);
+
+/*
+ * starts reading given file descriptor in background
+ * reader does not close fd, it should stay open until my_str_chunk_reader_close
+ * chunk_size: number of new bytes in every chunk (the last one may be shorter), if 0 then READ_CHUNK_SIZE
+ * depth: number of buffers read ahead, at least 2 are used
+ * overlap: number of last bytes of the previous chunk repeated in front of every chunk,
+ *      search for a pattern of length overlap + 1 in chunks finds matches across chunk edges
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if reader is NULL
+ *      IO_READ_ERR if fd is bad
+ *      MEMORY_ALLOCATION_ERR if there was an error during allocating buffers or starting thread
+ */
+int my_str_chunk_reader_open(my_str_chunk_reader_t* reader, int fd, size_t chunk_size, size_t depth, size_t overlap) {
+    if (!reader)
+        return NULL_PTR_ERR;
+
+    memset(reader, 0, sizeof(*reader));
+    if (fd < 0)
+        return IO_READ_ERR;
+
+    reader->fd = fd;
+    reader->chunk_size = chunk_size ? chunk_size : READ_CHUNK_SIZE;
+    // one slot is held by the caller, so one more is needed to read ahead
+    reader->depth = (depth < 2) ? 2 : depth;
+    reader->overlap = overlap;
+
+    if (reader->chunk_size > SIZE_MAX - overlap)
+        return MEMORY_ALLOCATION_ERR;
+
+    reader->slots = (my_str_chunk_slot_t *) calloc(reader->depth, sizeof(my_str_chunk_slot_t));
+    if (!reader->slots)
+        return MEMORY_ALLOCATION_ERR;
+
+    for (size_t i = 0; i < reader->depth; i++) {
+        reader->slots[i].data = (char *) malloc(reader->overlap + reader->chunk_size);
+        if (!reader->slots[i].data) {
+            free_slots(reader);
+            return MEMORY_ALLOCATION_ERR;
+        }
+    }
+
+    if (pthread_mutex_init(&reader->lock, NULL) != 0) {
+        free_slots(reader);
+        return MEMORY_ALLOCATION_ERR;
+    }
+    if (pthread_cond_init(&reader->changed, NULL) != 0) {
+        pthread_mutex_destroy(&reader->lock);
+        free_slots(reader);
+        return MEMORY_ALLOCATION_ERR;
+    }
+    if (pthread_create(&reader->thread, NULL, reader_thread, reader) != 0) {
+        pthread_cond_destroy(&reader->changed);
+        pthread_mutex_destroy(&reader->lock);
+        free_slots(reader);
+        return MEMORY_ALLOCATION_ERR;
+    }
+
+    return 0;
+}
+
+/*
+ * hands out the next chunk, previous chunk becomes invalid
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if reader or chunk is NULL
+ *      NOT_FOUND_CODE if there is no more data
+ *      IO_READ_ERR if there was error while reading
+ */
+int my_str_chunk_reader_next(my_str_chunk_reader_t* reader, my_str_chunk_t* chunk) {
+    if (!reader || !chunk || !reader->slots)
+        return NULL_PTR_ERR;
+
+    // slot held by caller is still counted as filled
+    size_t needed = reader->holding ? 2 : 1;
+    pthread_mutex_lock(&reader->lock);
+    while (reader->filled < needed)
+        pthread_cond_wait(&reader->changed, &reader->lock);
+    pthread_mutex_unlock(&reader->lock);
+
+    my_str_chunk_slot_t* next = &reader->slots[reader->consume_at];
+    // the end is not consumed, so that every next call reports it again
+    if (next->status != 0)
+        return next->status;
+
+    size_t carry = 0;
+    if (reader->holding) {
+        my_str_chunk_slot_t* prev = &reader->slots[(reader->consume_at + reader->depth - 1) % reader->depth];
+        size_t prev_size = reader->held_overlap + prev->size_m;
+        carry = (reader->overlap < prev_size) ? reader->overlap : prev_size;
+        // prefix of the slot is never written by the reading thread
+        memcpy(next->data + reader->overlap - carry,
+               prev->data + reader->overlap + prev->size_m - carry, carry);
+
+        pthread_mutex_lock(&reader->lock);
+        reader->filled--;
+        pthread_cond_broadcast(&reader->changed);
+        pthread_mutex_unlock(&reader->lock);
+    }
+
+    chunk->view.data = next->data + reader->overlap - carry;
+    chunk->view.size_m = carry + next->size_m;
+    chunk->offset = reader->position - carry;
+    chunk->overlap = carry;
+
+    reader->position += next->size_m;
+    reader->held_overlap = carry;
+    reader->holding = 1;
+    reader->consume_at = (reader->consume_at + 1) % reader->depth;
+
+    return 0;
+}
+
+/*
+ * stops background reading and frees all buffers of reader
+ * return:
+ *     0 always
+ */
+int my_str_chunk_reader_close(my_str_chunk_reader_t* reader) {
+    if (!reader || !reader->slots)
+        return 0;
+
+    pthread_mutex_lock(&reader->lock);
+    reader->stop = 1;
+    pthread_cond_broadcast(&reader->changed);
+    pthread_mutex_unlock(&reader->lock);
+
+    pthread_join(reader->thread, NULL);
+    pthread_cond_destroy(&reader->changed);
+    pthread_mutex_destroy(&reader->lock);
+    free_slots(reader);
+
+    return 0;
+}
+
+// fills free slots of the ring until EOF, error or close
+static void* reader_thread(void* arg) {
+    my_str_chunk_reader_t* reader = (my_str_chunk_reader_t *) arg;
+
+    for (;;) {
+        pthread_mutex_lock(&reader->lock);
+        while (reader->filled == reader->depth && !reader->stop)
+            pthread_cond_wait(&reader->changed, &reader->lock);
+        int stop = reader->stop;
+        my_str_chunk_slot_t* slot = &reader->slots[reader->produce_at];
+        pthread_mutex_unlock(&reader->lock);
+        if (stop)
+            break;
+
+        // full chunks are read even from pipes that return less at once
+        size_t got = 0;
+        int status = 0;
+        while (got < reader->chunk_size) {
+            ssize_t n = read(reader->fd, slot->data + reader->overlap + got, reader->chunk_size - got);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0) {
+                // the data that was read is handed out first, the end comes with the next slot
+                if (got == 0)
+                    status = (n == 0) ? NOT_FOUND_CODE : IO_READ_ERR;
+                break;
+            }
+            got += (size_t) n;
+        }
+
+        pthread_mutex_lock(&reader->lock);
+        slot->size_m = got;
+        slot->status = status;
+        reader->produce_at = (reader->produce_at + 1) % reader->depth;
+        reader->filled++;
+        pthread_cond_broadcast(&reader->changed);
+        pthread_mutex_unlock(&reader->lock);
+
+        if (status != 0)
+            break;
+    }
+
+    return NULL;
+}
+
+static void free_slots(my_str_chunk_reader_t* reader) {
+    for (size_t i = 0; i < reader->depth; i++)
+        free(reader->slots[i].data);
+
+    free(reader->slots);
+    reader->slots = NULL;
+}
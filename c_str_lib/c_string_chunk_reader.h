@@ -0,0 +1,74 @@
+#pragma once
+#ifndef C_STRING_CHUNK_READER_H
+#define C_STRING_CHUNK_READER_H
+
+#include <pthread.h>
+
+#include "c_string.h"
+
+// one chunk handed out by my_str_chunk_reader_next
+typedef struct {
+    my_str_view_t view; // overlap bytes of previous chunk followed by new data
+    size_t offset;      // position of view.data[0] counted from the start of reading
+    size_t overlap;     // number of leading bytes repeated from the previous chunk
+} my_str_chunk_t;
+
+// buffer of the reader ring, new data is read after overlap bytes of prefix
+typedef struct {
+    char *data;
+    size_t size_m;      // number of new bytes read into the slot
+    int status;         // 0, NOT_FOUND_CODE on EOF or IO_READ_ERR
+} my_str_chunk_slot_t;
+
+// reads file chunk by chunk, background thread fills next slots while caller processes current one
+typedef struct {
+    int fd;
+    size_t chunk_size;
+    size_t overlap;
+    size_t depth;              // number of slots in the ring
+    my_str_chunk_slot_t *slots;
+    size_t filled;             // slots filled by thread and not yet released by caller
+    size_t produce_at;         // slot that is filled next
+    size_t consume_at;         // slot that is handed out next
+    int holding;               // 1 if caller holds slot before consume_at
+    size_t held_overlap;       // overlap of the held chunk
+    int stop;
+    size_t position;           // offset of the next new byte handed out
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+} my_str_chunk_reader_t;
+
+/*
+ * starts reading given file descriptor in background
+ * reader does not close fd, it should stay open until my_str_chunk_reader_close
+ * chunk_size: number of new bytes in every chunk (the last one may be shorter), if 0 then READ_CHUNK_SIZE
+ * depth: number of buffers read ahead, at least 2 are used
+ * overlap: number of last bytes of the previous chunk repeated in front of every chunk,
+ *      search for a pattern of length overlap + 1 in chunks finds matches across chunk edges
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if reader is NULL
+ *      IO_READ_ERR if fd is bad
+ *      MEMORY_ALLOCATION_ERR if there was an error during allocating buffers or starting thread
+ */
+int my_str_chunk_reader_open(my_str_chunk_reader_t* reader, int fd, size_t chunk_size, size_t depth, size_t overlap);
+
+/*
+ * hands out the next chunk, previous chunk becomes invalid
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if reader or chunk is NULL
+ *      NOT_FOUND_CODE if there is no more data
+ *      IO_READ_ERR if there was error while reading
+ */
+int my_str_chunk_reader_next(my_str_chunk_reader_t* reader, my_str_chunk_t* chunk);
+
+/*
+ * stops background reading and frees all buffers of reader
+ * return:
+ *     0 always
+ */
+int my_str_chunk_reader_close(my_str_chunk_reader_t* reader);
+
+#endif // C_STRING_CHUNK_READER_H
@@ -0,0 +1,203 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_edit.h"
+
+static int cmp_edits(const void* a, const void* b);
+static int reserve_edits(my_str_edits_t* edits, size_t capacity);
+
+/*
+ * creates empty edit list
+ * !important! user should always use my_str_edits_create before using ANY other edit list function
+ * capacity: number of edits that can be added without growing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if edits is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edits_create(my_str_edits_t* edits, size_t capacity) {
+    if (!edits)
+        return NULL_PTR_ERR;
+
+    if (capacity > SIZE_MAX / sizeof(my_str_edit_t) - 1)
+        return MEMORY_ALLOCATION_ERR;
+
+    edits->edits = (my_str_edit_t *) malloc((capacity + 1) * sizeof(my_str_edit_t));
+    if (!edits->edits)
+        return MEMORY_ALLOCATION_ERR;
+
+    int err = my_str_create(&edits->arena, 0);
+    if (err != 0) {
+        free(edits->edits);
+        edits->edits = NULL;
+        return err;
+    }
+
+    edits->size_m = 0;
+    edits->capacity_m = capacity;
+
+    return 0;
+}
+
+/*
+ * frees all data of the edit list
+ * return:
+ *     0 always
+ */
+int my_str_edits_free(my_str_edits_t* edits) {
+    if (!edits)
+        return 0;
+
+    my_str_free(&edits->arena);
+    free(edits->edits);
+    edits->edits = NULL;
+    edits->size_m = edits->capacity_m = 0;
+
+    return 0;
+}
+
+/*
+ * removes all queued edits, memory is kept for reuse
+ * return:
+ *     0 always
+ */
+int my_str_edits_clear(my_str_edits_t* edits) {
+    if (!edits)
+        return 0;
+
+    // arena is reset directly, my_str_clear would zero all its capacity on every commit
+    edits->size_m = 0;
+    edits->arena.size_m = 0;
+    edits->arena.hash_m = 0;
+
+    return 0;
+}
+
+/*
+ * returns number of queued edits
+ * if edits == NULL than size = 0
+ */
+size_t my_str_edits_size(const my_str_edits_t* edits) {
+    if (!edits)
+        return 0;
+    return edits->size_m;
+}
+
+/*
+ * queues replacement of erase bytes beginning from pos of the original string by copy of insert,
+ * edits may be added in any order; edits at the same position are applied in order of adding
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if edits is NULL or insert has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edits_add(my_str_edits_t* edits, size_t pos, size_t erase, my_str_view_t insert) {
+    if (!edits || (!insert.data && insert.size_m))
+        return NULL_PTR_ERR;
+
+    if (edits->size_m == edits->capacity_m) {
+        int err = reserve_edits(edits, edits->capacity_m ? edits->capacity_m * 2 : 8);
+        if (err != 0) return err;
+    }
+
+    my_str_t* arena = &edits->arena;
+    if (insert.size_m > arena->capacity_m - arena->size_m) {
+        if (insert.size_m > SIZE_MAX / 2 - arena->size_m)
+            return MEMORY_ALLOCATION_ERR;
+        size_t needed = arena->size_m + insert.size_m;
+        int err = my_str_reserve(arena, (needed > arena->capacity_m * 2) ? needed : arena->capacity_m * 2);
+        if (err != 0) return err;
+    }
+
+    my_str_edit_t* edit = &edits->edits[edits->size_m];
+    edit->pos = pos;
+    edit->erase = erase;
+    edit->offset = arena->size_m;
+    edit->size_m = insert.size_m;
+    edit->seq = edits->size_m;
+    if (insert.size_m)
+        memcpy(arena->data + arena->size_m, insert.data, insert.size_m);
+    arena->size_m += insert.size_m;
+    edits->size_m++;
+
+    return 0;
+}
+
+/*
+ * applies all queued edits to the string and clears the list
+ * on error neither string nor list is changed
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if edits or str is NULL
+ *      RANGE_ERR if an edit is outside the string or erased ranges overlap
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edits_commit(my_str_edits_t* edits, my_str_t* str) {
+    if (!edits || !str)
+        return NULL_PTR_ERR;
+
+    // edits usually come in order, then sorting is skipped
+    size_t i;
+    for (i = 1; i < edits->size_m; i++)
+        if (edits->edits[i].pos < edits->edits[i - 1].pos)
+            break;
+    if (i < edits->size_m)
+        qsort(edits->edits, edits->size_m, sizeof(my_str_edit_t), cmp_edits);
+
+    // final size is known before anything is changed
+    size_t size = str->size_m, end = 0;
+    for (i = 0; i < edits->size_m; i++) {
+        const my_str_edit_t* edit = &edits->edits[i];
+        if (edit->pos < end || edit->pos > str->size_m || edit->erase > str->size_m - edit->pos)
+            return RANGE_ERR;
+        end = edit->pos + edit->erase;
+        size -= edit->erase;
+        if (edit->size_m > SIZE_MAX - 1 - size)
+            return MEMORY_ALLOCATION_ERR;
+        size += edit->size_m;
+    }
+
+    my_str_t result;
+    int err = my_str_create(&result, size);
+    if (err != 0) return err;
+
+    // one sweep: untouched bytes before every edit, then its inserted bytes
+    size_t from = 0;
+    for (i = 0; i < edits->size_m; i++) {
+        const my_str_edit_t* edit = &edits->edits[i];
+        memcpy(result.data + result.size_m, str->data + from, edit->pos - from);
+        result.size_m += edit->pos - from;
+        memcpy(result.data + result.size_m, edits->arena.data + edit->offset, edit->size_m);
+        result.size_m += edit->size_m;
+        from = edit->pos + edit->erase;
+    }
+    memcpy(result.data + result.size_m, str->data + from, str->size_m - from);
+    result.size_m += str->size_m - from;
+
+    my_str_free(str);
+    *str = result;
+    my_str_edits_clear(edits);
+
+    return 0;
+}
+
+static int cmp_edits(const void* a, const void* b) {
+    const my_str_edit_t* first = a;
+    const my_str_edit_t* second = b;
+    if (first->pos != second->pos)
+        return first->pos < second->pos ? -1 : 1;
+    return first->seq < second->seq ? -1 : (first->seq > second->seq);
+}
+
+static int reserve_edits(my_str_edits_t* edits, size_t capacity) {
+    if (capacity > SIZE_MAX / sizeof(my_str_edit_t) - 1)
+        return MEMORY_ALLOCATION_ERR;
+
+    my_str_edit_t* larger = (my_str_edit_t *) realloc(edits->edits, (capacity + 1) * sizeof(my_str_edit_t));
+    if (!larger)
+        return MEMORY_ALLOCATION_ERR;
+
+    edits->edits = larger;
+    edits->capacity_m = capacity;
+
+    return 0;
+}
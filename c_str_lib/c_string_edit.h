@@ -0,0 +1,80 @@
+#pragma once
+#ifndef C_STRING_EDIT_H
+#define C_STRING_EDIT_H
+
+#include "c_string.h"
+
+// one queued edit: erase bytes [pos, pos + erase) of the original string and put bytes there
+typedef struct {
+    size_t pos;       // position in the original string
+    size_t erase;     // number of erased bytes
+    size_t offset;    // beginning of inserted bytes in the arena
+    size_t size_m;    // number of inserted bytes
+    size_t seq;       // order of adding, keeps order of edits at the same position
+} my_str_edit_t;
+
+/*
+ * list of edits against offsets of the original string, applied all at once:
+ * the final size is computed first, so result is allocated once and built in one sweep
+ * instead of moving the tail of the string on every insert and erase
+ */
+typedef struct {
+    my_str_edit_t *edits;
+    size_t size_m;      // number of queued edits
+    size_t capacity_m;  // number of edits that fit without growing
+    my_str_t arena;     // copies of all inserted bytes
+} my_str_edits_t;
+
+/*
+ * creates empty edit list
+ * !important! user should always use my_str_edits_create before using ANY other edit list function
+ * capacity: number of edits that can be added without growing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if edits is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edits_create(my_str_edits_t* edits, size_t capacity);
+
+/*
+ * frees all data of the edit list
+ * return:
+ *     0 always
+ */
+int my_str_edits_free(my_str_edits_t* edits);
+
+/*
+ * removes all queued edits, memory is kept for reuse
+ * return:
+ *     0 always
+ */
+int my_str_edits_clear(my_str_edits_t* edits);
+
+/*
+ * returns number of queued edits
+ * if edits == NULL than size = 0
+ */
+size_t my_str_edits_size(const my_str_edits_t* edits);
+
+/*
+ * queues replacement of erase bytes beginning from pos of the original string by copy of insert,
+ * edits may be added in any order; edits at the same position are applied in order of adding
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if edits is NULL or insert has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edits_add(my_str_edits_t* edits, size_t pos, size_t erase, my_str_view_t insert);
+
+/*
+ * applies all queued edits to the string and clears the list
+ * on error neither string nor list is changed
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if edits or str is NULL
+ *      RANGE_ERR if an edit is outside the string or erased ranges overlap
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_edits_commit(my_str_edits_t* edits, my_str_t* str);
+
+#endif // C_STRING_EDIT_H
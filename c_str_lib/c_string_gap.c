@@ -0,0 +1,240 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_gap.h"
+
+static int reserve_gap(my_str_gap_t* gap, size_t extra);
+
+/*
+ * creates empty gap buffer with cursor at 0
+ * !important! user should always use my_str_gap_create before using ANY other gap buffer function
+ * capacity: number of bytes that can be inserted without growing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_gap_create(my_str_gap_t* gap, size_t capacity) {
+    if (!gap)
+        return NULL_PTR_ERR;
+
+    // malloc(0) may return NULL, so there is always at least one byte
+    gap->data = (char *) malloc(capacity ? capacity : 1);
+    if (!gap->data)
+        return MEMORY_ALLOCATION_ERR;
+
+    gap->capacity_m = capacity ? capacity : 1;
+    gap->gap_start = 0;
+    gap->gap_end = gap->capacity_m;
+    return 0;
+}
+
+/*
+ * frees the buffer
+ * return:
+ *     0 always
+ */
+int my_str_gap_free(my_str_gap_t* gap) {
+    if (!gap)
+        return 0;
+
+    free(gap->data);
+    gap->data = NULL;
+    gap->capacity_m = gap->gap_start = gap->gap_end = 0;
+    return 0;
+}
+
+/*
+ * returns number of bytes in the gap buffer
+ * if gap == NULL than size = 0
+ */
+size_t my_str_gap_size(const my_str_gap_t* gap) {
+    if (!gap)
+        return 0;
+    return gap->capacity_m - (gap->gap_end - gap->gap_start);
+}
+
+/*
+ * returns position of the cursor (the gap)
+ * if gap == NULL than cursor = 0
+ */
+size_t my_str_gap_cursor(const my_str_gap_t* gap) {
+    if (!gap)
+        return 0;
+    return gap->gap_start;
+}
+
+/*
+ * moves the gap to given position, bytes between old and new cursor are moved over the gap
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL
+ *      RANGE_ERR if pos is bigger than size
+ */
+int my_str_gap_move(my_str_gap_t* gap, size_t pos) {
+    if (!gap)
+        return NULL_PTR_ERR;
+    if (pos > my_str_gap_size(gap))
+        return RANGE_ERR;
+
+    if (pos < gap->gap_start) {
+        size_t moved = gap->gap_start - pos;
+        memmove(gap->data + gap->gap_end - moved, gap->data + pos, moved);
+        gap->gap_start -= moved;
+        gap->gap_end -= moved;
+    } else if (pos > gap->gap_start) {
+        size_t moved = pos - gap->gap_start;
+        memmove(gap->data + gap->gap_start, gap->data + gap->gap_end, moved);
+        gap->gap_start += moved;
+        gap->gap_end += moved;
+    }
+    return 0;
+}
+
+/*
+ * inserts given char at given position, cursor is left after it,
+ * so the next insert at pos + 1 moves nothing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL
+ *      RANGE_ERR if position is bad
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_gap_insert_c(my_str_gap_t* gap, char c, size_t pos) {
+    my_str_view_t from = {&c, 1};
+    return my_str_gap_insert(gap, from, pos);
+}
+
+/*
+ * inserts bytes at given position, cursor is left after them
+ * if needed buffer grows at least twice
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL or from has NULL data and non zero size
+ *      RANGE_ERR if position is bad
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_gap_insert(my_str_gap_t* gap, my_str_view_t from, size_t pos) {
+    if (!gap || (!from.data && from.size_m))
+        return NULL_PTR_ERR;
+    if (pos > my_str_gap_size(gap))
+        return RANGE_ERR;
+
+    int err = reserve_gap(gap, from.size_m);
+    if (err != 0) return err;
+
+    my_str_gap_move(gap, pos);
+    if (from.size_m)
+        memcpy(gap->data + gap->gap_start, from.data, from.size_m);
+    gap->gap_start += from.size_m;
+    return 0;
+}
+
+/*
+ * erases bytes [beg, end), cursor is left at beg; erasing bytes right before the cursor
+ * (backspace) or right after it (delete) moves nothing
+ * end > size is not an error - erase all possible
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL
+ *      RANGE_ERR if boundaries are bad
+ */
+int my_str_gap_erase(my_str_gap_t* gap, size_t beg, size_t end) {
+    if (!gap)
+        return NULL_PTR_ERR;
+
+    size_t size = my_str_gap_size(gap);
+    end = end < size ? end : size;
+    if (beg > size || end < beg)
+        return RANGE_ERR;
+
+    if (end == gap->gap_start) {
+        // erased bytes just join the gap from the left
+        gap->gap_start = beg;
+        return 0;
+    }
+
+    my_str_gap_move(gap, beg);
+    gap->gap_end += end - beg;
+    return 0;
+}
+
+/*
+ * saves byte at given index to c
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap or c is NULL
+ *      RANGE_ERR if index is bad
+ */
+int my_str_gap_getc(const my_str_gap_t* gap, size_t index, char* c) {
+    if (!gap || !c)
+        return NULL_PTR_ERR;
+    if (index >= my_str_gap_size(gap))
+        return RANGE_ERR;
+
+    *c = index < gap->gap_start ? gap->data[index] : gap->data[index + gap->gap_end - gap->gap_start];
+    return 0;
+}
+
+/*
+ * moves the gap to the end, so all bytes are contiguous, and saves view of them
+ * view is valid until the next change of the gap buffer
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap or view is NULL
+ */
+int my_str_gap_view(my_str_gap_t* gap, my_str_view_t* view) {
+    if (!gap || !view)
+        return NULL_PTR_ERR;
+
+    my_str_gap_move(gap, my_str_gap_size(gap));
+    view->data = gap->data;
+    view->size_m = gap->gap_start;
+    return 0;
+}
+
+/*
+ * copies content into my_str-string, gap buffer is not changed
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap or str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_gap_to_str(const my_str_gap_t* gap, my_str_t* str) {
+    if (!gap || !str)
+        return NULL_PTR_ERR;
+
+    // old content is not needed, so it is not copied by reserve
+    str->size_m = 0;
+    str->hash_m = 0;
+    size_t tail = gap->capacity_m - gap->gap_end;
+    int err = my_str_reserve(str, gap->gap_start + tail);
+    if (err != 0) return err;
+
+    memcpy(str->data, gap->data, gap->gap_start);
+    memcpy(str->data + gap->gap_start, gap->data + gap->gap_end, tail);
+    str->size_m = gap->gap_start + tail;
+    return 0;
+}
+
+// makes the gap at least extra bytes long, buffer grows at least twice,
+// bytes after the gap are moved to the end of the new buffer
+static int reserve_gap(my_str_gap_t* gap, size_t extra) {
+    if (extra <= gap->gap_end - gap->gap_start)
+        return 0;
+
+    size_t size = my_str_gap_size(gap);
+    if (extra > SIZE_MAX / 2 - size)
+        return MEMORY_ALLOCATION_ERR;
+
+    size_t capacity = size + extra > gap->capacity_m * 2 ? size + extra : gap->capacity_m * 2;
+    char* data = (char *) realloc(gap->data, capacity);
+    if (!data)
+        return MEMORY_ALLOCATION_ERR;
+
+    size_t tail = gap->capacity_m - gap->gap_end;
+    memmove(data + capacity - tail, data + gap->gap_end, tail);
+    gap->data = data;
+    gap->gap_end = capacity - tail;
+    gap->capacity_m = capacity;
+    return 0;
+}
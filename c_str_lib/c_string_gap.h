@@ -0,0 +1,119 @@
+#pragma once
+#ifndef C_STRING_GAP_H
+#define C_STRING_GAP_H
+
+#include "c_string.h"
+
+/*
+ * string with a movable gap of free space at the cursor (gap buffer): bytes before the gap,
+ * free space, bytes after the gap; inserts and erases at the cursor only change the edges
+ * of the gap, so bursts of edits at nearly the same position are O(1) amortized and only
+ * moving the cursor costs the distance it is moved
+ */
+typedef struct {
+    char *data;
+    size_t capacity_m;  // bytes of buffer including the gap
+    size_t gap_start;   // cursor, number of bytes before the gap
+    size_t gap_end;     // beginning of bytes after the gap
+} my_str_gap_t;
+
+/*
+ * creates empty gap buffer with cursor at 0
+ * !important! user should always use my_str_gap_create before using ANY other gap buffer function
+ * capacity: number of bytes that can be inserted without growing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_gap_create(my_str_gap_t* gap, size_t capacity);
+
+/*
+ * frees the buffer
+ * return:
+ *     0 always
+ */
+int my_str_gap_free(my_str_gap_t* gap);
+
+/*
+ * returns number of bytes in the gap buffer
+ * if gap == NULL than size = 0
+ */
+size_t my_str_gap_size(const my_str_gap_t* gap);
+
+/*
+ * returns position of the cursor (the gap)
+ * if gap == NULL than cursor = 0
+ */
+size_t my_str_gap_cursor(const my_str_gap_t* gap);
+
+/*
+ * moves the gap to given position, bytes between old and new cursor are moved over the gap
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL
+ *      RANGE_ERR if pos is bigger than size
+ */
+int my_str_gap_move(my_str_gap_t* gap, size_t pos);
+
+/*
+ * inserts given char at given position, cursor is left after it,
+ * so the next insert at pos + 1 moves nothing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL
+ *      RANGE_ERR if position is bad
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_gap_insert_c(my_str_gap_t* gap, char c, size_t pos);
+
+/*
+ * inserts bytes at given position, cursor is left after them
+ * if needed buffer grows at least twice
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL or from has NULL data and non zero size
+ *      RANGE_ERR if position is bad
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_gap_insert(my_str_gap_t* gap, my_str_view_t from, size_t pos);
+
+/*
+ * erases bytes [beg, end), cursor is left at beg; erasing bytes right before the cursor
+ * (backspace) or right after it (delete) moves nothing
+ * end > size is not an error - erase all possible
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap is NULL
+ *      RANGE_ERR if boundaries are bad
+ */
+int my_str_gap_erase(my_str_gap_t* gap, size_t beg, size_t end);
+
+/*
+ * saves byte at given index to c
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap or c is NULL
+ *      RANGE_ERR if index is bad
+ */
+int my_str_gap_getc(const my_str_gap_t* gap, size_t index, char* c);
+
+/*
+ * moves the gap to the end, so all bytes are contiguous, and saves view of them
+ * view is valid until the next change of the gap buffer
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap or view is NULL
+ */
+int my_str_gap_view(my_str_gap_t* gap, my_str_view_t* view);
+
+/*
+ * copies content into my_str-string, gap buffer is not changed
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if gap or str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_gap_to_str(const my_str_gap_t* gap, my_str_t* str);
+
+#endif // C_STRING_GAP_H
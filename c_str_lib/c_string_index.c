@@ -0,0 +1,733 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_index.h"
+
+#define EMPTY SIZE_MAX
+#define INDEX_MAGIC "MYSTRIDX"
+#define INDEX_VERSION 1u
+
+// text of SA-IS: bytes of the original text with virtual sentinel or names of reduced problem
+typedef struct {
+    const unsigned char* bytes;
+    const size_t* names;
+    size_t size;            // including the sentinel
+} sa_text_t;
+
+// header of saved index
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t word_size;     // sizeof(size_t) of the machine that saved the index
+    uint32_t reserved;
+    uint64_t size;
+} index_header_t;
+
+static int suffix_array(const unsigned char* text, size_t size, size_t** result);
+static int sais(const sa_text_t* s, size_t* sa, size_t n, size_t k);
+static size_t sa_chr(const sa_text_t* s, size_t i);
+static void get_buckets(const sa_text_t* s, size_t* bkt, size_t n, size_t k, int end);
+static void induce_l(const unsigned char* t, size_t* sa, const sa_text_t* s, size_t* bkt, size_t n, size_t k);
+static void induce_s(const unsigned char* t, size_t* sa, const sa_text_t* s, size_t* bkt, size_t n, size_t k);
+static int build_fm(my_str_index_t* index, const unsigned char* text, const size_t* sa);
+static int prepare_fm(my_str_index_t* index);
+static size_t fm_occ(const my_str_index_t* index, unsigned char c, size_t row);
+static int fm_check(const my_str_index_t* index);
+static size_t fm_position(const my_str_index_t* index, size_t row);
+static size_t marked_count(const my_str_index_t* index);
+static int suffix_cmp(const my_str_index_t* index, size_t row, my_str_view_t pattern);
+static void find_rows(const my_str_index_t* index, my_str_view_t pattern, size_t* first, size_t* last);
+static size_t row_position(const my_str_index_t* index, size_t row);
+static int position_cmp(const void* a, const void* b);
+static unsigned popcount64(uint64_t x);
+static int write_all(FILE* file, const void* data, size_t size);
+static int read_all(FILE* file, void* data, size_t size);
+
+/*
+ * builds index of the text with SA-IS algorithm in linear time
+ * text is copied (suffix array mode) or not needed anymore (FM-index mode)
+ * flags: MY_STR_INDEX_FM or 0
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index or text is NULL
+ *      RANGE_ERR if text is too large for FM-index
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_index_build(my_str_index_t* index, const my_str_t* text, int flags) {
+    if (!index || !text)
+        return NULL_PTR_ERR;
+
+    memset(index, 0, sizeof(my_str_index_t));
+    index->flags = flags & MY_STR_INDEX_FM;
+    index->size_m = text->size_m;
+
+    if ((index->flags & MY_STR_INDEX_FM) && text->size_m >= UINT32_MAX)
+        return RANGE_ERR;
+
+    size_t* sa = NULL;
+    int err = suffix_array((const unsigned char *) text->data, text->size_m, &sa);
+    if (err != 0) return err;
+
+    if (index->flags & MY_STR_INDEX_FM) {
+        err = build_fm(index, (const unsigned char *) text->data, sa);
+        free(sa);
+    } else {
+        index->sa = sa;
+        err = my_str_create(&index->text, text->size_m);
+        if (err == 0) {
+            if (text->size_m)
+                memcpy(index->text.data, text->data, text->size_m);
+            index->text.size_m = text->size_m;
+        }
+    }
+
+    if (err != 0)
+        my_str_index_free(index);
+
+    return err;
+}
+
+/*
+ * frees all data of the index
+ * return:
+ *     0 always
+ */
+int my_str_index_free(my_str_index_t* index) {
+    if (!index)
+        return 0;
+
+    my_str_free(&index->text);
+    free(index->sa);
+    free(index->bwt);
+    free(index->occ);
+    free(index->marks);
+    free(index->mark_ranks);
+    free(index->samples);
+    index->sa = NULL;
+    index->bwt = NULL;
+    index->occ = NULL;
+    index->marks = NULL;
+    index->mark_ranks = NULL;
+    index->samples = NULL;
+    index->size_m = 0;
+
+    return 0;
+}
+
+/*
+ * counts occurrences of the pattern in the text, empty pattern never occurs
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index or count is NULL
+ */
+int my_str_index_count(const my_str_index_t* index, my_str_view_t pattern, size_t* count) {
+    if (!index || !count || (!pattern.data && pattern.size_m))
+        return NULL_PTR_ERR;
+
+    size_t first, last;
+    find_rows(index, pattern, &first, &last);
+    *count = last - first;
+
+    return 0;
+}
+
+/*
+ * finds the first occurrence of the pattern like my_str_find, but every occurrence is looked at
+ * return:
+ *      0  if OK
+ *      NOT_FOUND_CODE if there is no such pattern in text
+ *      NULL_PTR_ERR if index or pos is NULL
+ */
+int my_str_index_find(const my_str_index_t* index, my_str_view_t pattern, size_t* pos) {
+    if (!index || !pos || (!pattern.data && pattern.size_m))
+        return NULL_PTR_ERR;
+
+    size_t first, last;
+    find_rows(index, pattern, &first, &last);
+    if (first == last)
+        return NOT_FOUND_CODE;
+
+    // suffixes are sorted by content, not by position, so all of them are looked at
+    size_t min = SIZE_MAX;
+    for (size_t row = first; row < last; row++) {
+        size_t position = row_position(index, row);
+        if (position < min)
+            min = position;
+    }
+    *pos = min;
+
+    return 0;
+}
+
+/*
+ * saves positions of occurrences of the pattern in increasing order
+ * if there are more than max occurrences, only some max of them are saved
+ * count: if not NULL, number of all occurrences is saved there
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index is NULL or positions is NULL and max is not 0
+ */
+int my_str_index_locate(const my_str_index_t* index, my_str_view_t pattern,
+                        size_t* positions, size_t max, size_t* count) {
+    if (!index || (!positions && max) || (!pattern.data && pattern.size_m))
+        return NULL_PTR_ERR;
+
+    size_t first, last;
+    find_rows(index, pattern, &first, &last);
+    if (count) *count = last - first;
+
+    size_t saved = (last - first < max) ? last - first : max;
+    for (size_t i = 0; i < saved; i++)
+        positions[i] = row_position(index, first + i);
+    if (saved > 1)
+        qsort(positions, saved, sizeof(size_t), position_cmp);
+
+    return 0;
+}
+
+/*
+ * returns number of bytes allocated by the index
+ * if index == NULL than memory = 0
+ */
+size_t my_str_index_memory(const my_str_index_t* index) {
+    if (!index)
+        return 0;
+
+    if (!(index->flags & MY_STR_INDEX_FM))
+        return index->sa ? index->text.capacity_m + (index->size_m + 1) * sizeof(size_t) : 0;
+
+    if (!index->bwt)
+        return 0;
+
+    size_t rows = index->size_m + 1;
+    size_t words = rows / 64 + 1;
+    return rows + (rows / MY_STR_INDEX_OCC_STEP + 1) * index->sigma * sizeof(uint32_t) +
+           words * (sizeof(uint64_t) + sizeof(uint32_t)) + marked_count(index) * sizeof(uint32_t);
+}
+
+/*
+ * writes index to binary file, so it can be loaded without building again
+ * file is in byte order of this machine
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index or file is NULL
+ *      IO_WRITE_ERR if error occurred while writing
+ */
+int my_str_index_save(const my_str_index_t* index, FILE* file) {
+    if (!index || !file || (!index->sa && !index->bwt))
+        return NULL_PTR_ERR;
+
+    index_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version = INDEX_VERSION;
+    header.flags = (uint32_t) index->flags;
+    header.word_size = (uint32_t) sizeof(size_t);
+    header.size = index->size_m;
+
+    int err = write_all(file, &header, sizeof(header));
+    size_t rows = index->size_m + 1;
+    if (!(index->flags & MY_STR_INDEX_FM)) {
+        // suffix array is saved as is, the rest is cheap to compute again
+        if (err == 0) err = write_all(file, index->text.data, index->size_m);
+        if (err == 0) err = write_all(file, index->sa, rows * sizeof(size_t));
+    } else {
+        uint64_t primary = index->primary;
+        if (err == 0) err = write_all(file, &primary, sizeof(primary));
+        if (err == 0) err = write_all(file, index->bwt, rows);
+        if (err == 0) err = write_all(file, index->marks, (rows / 64 + 1) * sizeof(uint64_t));
+        if (err == 0) err = write_all(file, index->samples, marked_count(index) * sizeof(uint32_t));
+    }
+
+    if (err == 0 && fflush(file) != 0)
+        err = IO_WRITE_ERR;
+
+    return err;
+}
+
+/*
+ * reads index written by my_str_index_save
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index or file is NULL
+ *      IO_READ_ERR if file can not be read or it is not a saved index
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_index_load(my_str_index_t* index, FILE* file) {
+    if (!index || !file)
+        return NULL_PTR_ERR;
+
+    memset(index, 0, sizeof(my_str_index_t));
+
+    index_header_t header;
+    if (read_all(file, &header, sizeof(header)) != 0 ||
+        memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != INDEX_VERSION || header.word_size != sizeof(size_t) ||
+        (header.flags & ~(uint32_t) MY_STR_INDEX_FM) || header.size >= SIZE_MAX / sizeof(size_t) ||
+        ((header.flags & MY_STR_INDEX_FM) && header.size >= UINT32_MAX))
+        return IO_READ_ERR;
+
+    index->flags = (int) header.flags;
+    index->size_m = (size_t) header.size;
+    size_t rows = index->size_m + 1;
+
+    int err = 0;
+    if (!(index->flags & MY_STR_INDEX_FM)) {
+        index->sa = (size_t *) malloc(rows * sizeof(size_t));
+        err = index->sa ? my_str_create(&index->text, index->size_m) : MEMORY_ALLOCATION_ERR;
+        if (err == 0) err = read_all(file, index->text.data, index->size_m);
+        if (err == 0) err = read_all(file, index->sa, rows * sizeof(size_t));
+        if (err == 0) {
+            index->text.size_m = index->size_m;
+            for (size_t i = 0; i < rows && err == 0; i++)
+                if (index->sa[i] > index->size_m)
+                    err = IO_READ_ERR;
+        }
+    } else {
+        uint64_t primary = 0;
+        size_t words = rows / 64 + 1;
+        index->bwt = (unsigned char *) malloc(rows);
+        index->marks = (uint64_t *) malloc(words * sizeof(uint64_t));
+        if (!index->bwt || !index->marks)
+            err = MEMORY_ALLOCATION_ERR;
+        if (err == 0) err = read_all(file, &primary, sizeof(primary));
+        if (err == 0) err = read_all(file, index->bwt, rows);
+        if (err == 0) err = read_all(file, index->marks, words * sizeof(uint64_t));
+        if (err == 0 && primary >= rows)
+            err = IO_READ_ERR;
+        if (err == 0) {
+            index->primary = (size_t) primary;
+            err = prepare_fm(index);
+        }
+        // locate walks back until a marked row, so every text position divisible by the step,
+        // the whole text at primary row too, must be marked, and nothing after the last row
+        size_t samples = 0;
+        if (err == 0) {
+            samples = marked_count(index);
+            if (samples != index->size_m / MY_STR_INDEX_SAMPLE_STEP + 1 ||
+                !((index->marks[index->primary / 64] >> (index->primary % 64)) & 1) ||
+                (index->marks[rows / 64] >> (rows % 64)))
+                err = IO_READ_ERR;
+        }
+        if (err == 0) {
+            index->samples = (uint32_t *) malloc(samples * sizeof(uint32_t) + 1);
+            err = index->samples ? read_all(file, index->samples, samples * sizeof(uint32_t)) : MEMORY_ALLOCATION_ERR;
+            for (size_t i = 0; i < samples && err == 0; i++)
+                if (index->samples[i] > index->size_m || index->samples[i] % MY_STR_INDEX_SAMPLE_STEP)
+                    err = IO_READ_ERR;
+        }
+        if (err == 0)
+            err = fm_check(index);
+    }
+
+    if (err != 0)
+        my_str_index_free(index);
+
+    return err;
+}
+
+// suffix array of text with the empty suffix, size + 1 elements
+static int suffix_array(const unsigned char* text, size_t size, size_t** result) {
+    if (size >= SIZE_MAX / sizeof(size_t))
+        return MEMORY_ALLOCATION_ERR;
+
+    size_t* sa = (size_t *) malloc((size + 1) * sizeof(size_t));
+    if (!sa)
+        return MEMORY_ALLOCATION_ERR;
+
+    int err = 0;
+    if (size == 0) {
+        sa[0] = 0;
+    } else {
+        sa_text_t s = {text, NULL, size + 1};
+        err = sais(&s, sa, size + 1, 257);
+    }
+
+    if (err != 0) {
+        free(sa);
+        return err;
+    }
+
+    *result = sa;
+    return 0;
+}
+
+#define T_GET(t, i) (((t)[(i) / 8] >> ((i) % 8)) & 1)
+#define T_SET(t, i) ((t)[(i) / 8] |= (unsigned char) (1u << ((i) % 8)))
+#define IS_LMS(t, i) ((i) > 0 && T_GET(t, i) && !T_GET(t, (i) - 1))
+
+/*
+ * SA-IS by Nong, Zhang and Chan: s[0..n - 1] with symbols in [0, k) and unique smallest
+ * symbol at the end, n >= 2; reduced problem and its names are kept inside sa
+ */
+static int sais(const sa_text_t* s, size_t* sa, size_t n, size_t k) {
+    // types of suffixes: bit is set for S-type (smaller than the next one)
+    unsigned char* t = (unsigned char *) calloc(n / 8 + 1, 1);
+    size_t* bkt = (size_t *) malloc(k * sizeof(size_t));
+    if (!t || !bkt) {
+        free(t);
+        free(bkt);
+        return MEMORY_ALLOCATION_ERR;
+    }
+
+    T_SET(t, n - 1);
+    for (size_t i = n - 1; i-- > 0;) {
+        size_t c = sa_chr(s, i), next = sa_chr(s, i + 1);
+        if (c < next || (c == next && T_GET(t, i + 1)))
+            T_SET(t, i);
+    }
+
+    // stage 1: sorts LMS substrings by inducing from unsorted LMS positions
+    get_buckets(s, bkt, n, k, 1);
+    for (size_t i = 0; i < n; i++)
+        sa[i] = EMPTY;
+    for (size_t i = 1; i < n; i++)
+        if (IS_LMS(t, i))
+            sa[--bkt[sa_chr(s, i)]] = i;
+    induce_l(t, sa, s, bkt, n, k);
+    induce_s(t, sa, s, bkt, n, k);
+
+    // sorted LMS substrings are moved to the beginning, at most n / 2 of them
+    size_t n1 = 0;
+    for (size_t i = 0; i < n; i++)
+        if (sa[i] != EMPTY && IS_LMS(t, sa[i]))
+            sa[n1++] = sa[i];
+
+    // equal LMS substrings get equal names
+    for (size_t i = n1; i < n; i++)
+        sa[i] = EMPTY;
+    size_t name = 0, prev = EMPTY;
+    for (size_t i = 0; i < n1; i++) {
+        size_t pos = sa[i];
+        int diff = 0;
+        for (size_t d = 0; d < n; d++) {
+            if (prev == EMPTY || sa_chr(s, pos + d) != sa_chr(s, prev + d) || T_GET(t, pos + d) != T_GET(t, prev + d)) {
+                diff = 1;
+                break;
+            }
+            if (d > 0 && (IS_LMS(t, pos + d) || IS_LMS(t, prev + d)))
+                break;
+        }
+        if (diff) {
+            name++;
+            prev = pos;
+        }
+        sa[n1 + pos / 2] = name - 1;
+    }
+    for (size_t i = n, j = n; i-- > n1;)
+        if (sa[i] != EMPTY)
+            sa[--j] = sa[i];
+
+    // stage 2: sorts suffixes of the reduced string, recursively if names are not unique yet
+    size_t* sa1 = sa;
+    size_t* s1 = sa + n - n1;
+    int err = 0;
+    if (name < n1) {
+        sa_text_t reduced = {NULL, s1, n1};
+        err = sais(&reduced, sa1, n1, name);
+    } else {
+        for (size_t i = 0; i < n1; i++)
+            sa1[s1[i]] = i;
+    }
+
+    // stage 3: induces the order of all suffixes from sorted LMS suffixes
+    if (err == 0) {
+        get_buckets(s, bkt, n, k, 1);
+        for (size_t i = 1, j = 0; i < n; i++)
+            if (IS_LMS(t, i))
+                s1[j++] = i;
+        for (size_t i = 0; i < n1; i++)
+            sa1[i] = s1[sa1[i]];
+        for (size_t i = n1; i < n; i++)
+            sa[i] = EMPTY;
+        for (size_t i = n1; i-- > 0;) {
+            size_t j = sa[i];
+            sa[i] = EMPTY;
+            sa[--bkt[sa_chr(s, j)]] = j;
+        }
+        induce_l(t, sa, s, bkt, n, k);
+        induce_s(t, sa, s, bkt, n, k);
+    }
+
+    free(bkt);
+    free(t);
+    return err;
+}
+
+static size_t sa_chr(const sa_text_t* s, size_t i) {
+    if (s->names)
+        return s->names[i];
+    return (i + 1 < s->size) ? (size_t) s->bytes[i] + 1 : 0;
+}
+
+// starts (or ends if end is not 0) of buckets of every symbol
+static void get_buckets(const sa_text_t* s, size_t* bkt, size_t n, size_t k, int end) {
+    memset(bkt, 0, k * sizeof(size_t));
+    for (size_t i = 0; i < n; i++)
+        bkt[sa_chr(s, i)]++;
+
+    size_t sum = 0;
+    for (size_t c = 0; c < k; c++) {
+        sum += bkt[c];
+        bkt[c] = end ? sum : sum - bkt[c];
+    }
+}
+
+// puts L-type suffixes after sorted ones from left to right
+static void induce_l(const unsigned char* t, size_t* sa, const sa_text_t* s, size_t* bkt, size_t n, size_t k) {
+    get_buckets(s, bkt, n, k, 0);
+    for (size_t i = 0; i < n; i++) {
+        if (sa[i] == EMPTY || sa[i] == 0)
+            continue;
+        size_t j = sa[i] - 1;
+        if (!T_GET(t, j))
+            sa[bkt[sa_chr(s, j)]++] = j;
+    }
+}
+
+// puts S-type suffixes before sorted ones from right to left
+static void induce_s(const unsigned char* t, size_t* sa, const sa_text_t* s, size_t* bkt, size_t n, size_t k) {
+    get_buckets(s, bkt, n, k, 1);
+    for (size_t i = n; i-- > 0;) {
+        if (sa[i] == EMPTY || sa[i] == 0)
+            continue;
+        size_t j = sa[i] - 1;
+        if (T_GET(t, j))
+            sa[--bkt[sa_chr(s, j)]] = j;
+    }
+}
+
+// transform and sampled suffix array, everything else is computed from them
+static int build_fm(my_str_index_t* index, const unsigned char* text, const size_t* sa) {
+    size_t rows = index->size_m + 1;
+    size_t words = rows / 64 + 1;
+
+    index->bwt = (unsigned char *) malloc(rows);
+    index->marks = (uint64_t *) calloc(words, sizeof(uint64_t));
+    index->samples = (uint32_t *) malloc((index->size_m / MY_STR_INDEX_SAMPLE_STEP + 1) * sizeof(uint32_t));
+    if (!index->bwt || !index->marks || !index->samples)
+        return MEMORY_ALLOCATION_ERR;
+
+    size_t samples = 0;
+    for (size_t row = 0; row < rows; row++) {
+        if (sa[row] == 0) {
+            index->primary = row;
+            index->bwt[row] = 0;
+        } else {
+            index->bwt[row] = text[sa[row] - 1];
+        }
+
+        if (sa[row] % MY_STR_INDEX_SAMPLE_STEP == 0) {
+            index->marks[row / 64] |= (uint64_t) 1 << (row % 64);
+            index->samples[samples++] = (uint32_t) sa[row];
+        }
+    }
+
+    return prepare_fm(index);
+}
+
+// symbol counts, occurrence checkpoints and ranks of marks
+static int prepare_fm(my_str_index_t* index) {
+    size_t rows = index->size_m + 1;
+    size_t words = rows / 64 + 1;
+
+    size_t freq[256] = {0};
+    for (size_t row = 0; row < rows; row++)
+        freq[index->bwt[row]]++;
+    freq[index->bwt[index->primary]]--;
+
+    index->sigma = 0;
+    index->counts[0] = 1; // the empty suffix is the smallest
+    for (size_t c = 0; c < 256; c++) {
+        index->codes[c] = (int16_t) (freq[c] ? (int) index->sigma++ : -1);
+        index->counts[c + 1] = index->counts[c] + freq[c];
+    }
+
+    size_t checkpoints = rows / MY_STR_INDEX_OCC_STEP + 1;
+    index->occ = (uint32_t *) malloc(checkpoints * index->sigma * sizeof(uint32_t) + 1);
+    index->mark_ranks = (uint32_t *) malloc(words * sizeof(uint32_t));
+    if (!index->occ || !index->mark_ranks)
+        return MEMORY_ALLOCATION_ERR;
+
+    uint32_t current[256] = {0};
+    for (size_t row = 0; row < checkpoints * MY_STR_INDEX_OCC_STEP; row++) {
+        if (row % MY_STR_INDEX_OCC_STEP == 0)
+            for (size_t c = 0; c < 256; c++)
+                if (index->codes[c] >= 0)
+                    index->occ[row / MY_STR_INDEX_OCC_STEP * index->sigma + (size_t) index->codes[c]] = current[c];
+        if (row < rows && row != index->primary)
+            current[index->bwt[row]]++;
+    }
+
+    uint32_t rank = 0;
+    for (size_t w = 0; w < words; w++) {
+        index->mark_ranks[w] = rank;
+        rank += popcount64(index->marks[w]);
+    }
+
+    return 0;
+}
+
+// number of symbols c in rows [0, row) of transform
+static size_t fm_occ(const my_str_index_t* index, unsigned char c, size_t row) {
+    int16_t code = index->codes[c];
+    if (code < 0)
+        return 0;
+
+    // counts from the nearest checkpoint, before or after the row
+    size_t block = row / MY_STR_INDEX_OCC_STEP;
+    size_t from = block * MY_STR_INDEX_OCC_STEP;
+    size_t next = from + MY_STR_INDEX_OCC_STEP;
+    size_t rows = index->size_m + 1;
+    const unsigned char* bwt = index->bwt;
+
+    if (row - from > MY_STR_INDEX_OCC_STEP / 2 && next <= rows) {
+        size_t result = index->occ[(block + 1) * index->sigma + (size_t) code];
+        for (size_t i = row; i < next; i++)
+            result -= (bwt[i] == c);
+        if (c == bwt[index->primary] && index->primary >= row && index->primary < next)
+            result++;
+        return result;
+    }
+
+    size_t result = index->occ[block * index->sigma + (size_t) code];
+    for (size_t i = from; i < row; i++)
+        result += (bwt[i] == c);
+    if (c == bwt[index->primary] && index->primary >= from && index->primary < row)
+        result--;
+    return result;
+}
+
+// walks LF mapping back from the empty suffix over the whole text: it must visit every row once
+// and end at primary row, and exactly positions divisible by the step must be marked with right
+// samples; any transform is some permutation of rows, and locate of a row on a cycle without
+// marks would never stop
+static int fm_check(const my_str_index_t* index) {
+    size_t row = 0;
+    for (size_t pos = index->size_m + 1; pos-- > 0;) {
+        if ((row == index->primary) != (pos == 0))
+            return IO_READ_ERR;
+
+        int marked = (int) ((index->marks[row / 64] >> (row % 64)) & 1);
+        if (marked != (pos % MY_STR_INDEX_SAMPLE_STEP == 0))
+            return IO_READ_ERR;
+        if (marked) {
+            uint64_t before = index->marks[row / 64] & (((uint64_t) 1 << (row % 64)) - 1);
+            if (index->samples[index->mark_ranks[row / 64] + popcount64(before)] != pos)
+                return IO_READ_ERR;
+        }
+
+        if (pos > 0) {
+            unsigned char c = index->bwt[row];
+            row = index->counts[c] + fm_occ(index, c, row);
+        }
+    }
+
+    return 0;
+}
+
+// walks back in text until the sampled position, primary row is always sampled
+static size_t fm_position(const my_str_index_t* index, size_t row) {
+    size_t steps = 0;
+    while (!((index->marks[row / 64] >> (row % 64)) & 1)) {
+        unsigned char c = index->bwt[row];
+        row = index->counts[c] + fm_occ(index, c, row);
+        steps++;
+    }
+
+    uint64_t before = index->marks[row / 64] & (((uint64_t) 1 << (row % 64)) - 1);
+    return index->samples[index->mark_ranks[row / 64] + popcount64(before)] + steps;
+}
+
+static size_t marked_count(const my_str_index_t* index) {
+    size_t last = (index->size_m + 1) / 64;
+    return index->mark_ranks[last] + popcount64(index->marks[last]);
+}
+
+// compares suffix with the pattern, 0 if the pattern is its prefix
+static int suffix_cmp(const my_str_index_t* index, size_t row, my_str_view_t pattern) {
+    size_t pos = index->sa[row];
+    size_t left = index->size_m - pos;
+    size_t n = (left < pattern.size_m) ? left : pattern.size_m;
+    int res = n ? memcmp(index->text.data + pos, pattern.data, n) : 0;
+    if (res != 0)
+        return res;
+
+    return (left < pattern.size_m) ? -1 : 0;
+}
+
+// rows [first, last) of suffixes that start with the pattern
+static void find_rows(const my_str_index_t* index, my_str_view_t pattern, size_t* first, size_t* last) {
+    *first = *last = 0;
+    if (!pattern.size_m || (!index->sa && !index->bwt))
+        return;
+
+    if (index->flags & MY_STR_INDEX_FM) {
+        // backward search, every symbol of pattern narrows the range of rows
+        size_t sp = 0, ep = index->size_m + 1;
+        for (size_t i = pattern.size_m; i-- > 0 && sp < ep;) {
+            unsigned char c = (unsigned char) pattern.data[i];
+            if (index->codes[c] < 0)
+                return;
+            sp = index->counts[c] + fm_occ(index, c, sp);
+            ep = index->counts[c] + fm_occ(index, c, ep);
+        }
+        if (sp < ep) {
+            *first = sp;
+            *last = ep;
+        }
+        return;
+    }
+
+    size_t lo = 0, hi = index->size_m + 1;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (suffix_cmp(index, mid, pattern) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    *first = lo;
+
+    hi = index->size_m + 1;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (suffix_cmp(index, mid, pattern) <= 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    *last = lo;
+}
+
+static size_t row_position(const my_str_index_t* index, size_t row) {
+    return (index->flags & MY_STR_INDEX_FM) ? fm_position(index, row) : index->sa[row];
+}
+
+static int position_cmp(const void* a, const void* b) {
+    size_t x = *(const size_t *) a, y = *(const size_t *) b;
+    return (x > y) - (x < y);
+}
+
+static unsigned popcount64(uint64_t x) {
+#ifdef __GNUC__
+    return (unsigned) __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (unsigned) ((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+static int write_all(FILE* file, const void* data, size_t size) {
+    if (size && fwrite(data, 1, size, file) != size)
+        return IO_WRITE_ERR;
+    return 0;
+}
+
+static int read_all(FILE* file, void* data, size_t size) {
+    if (size && fread(data, 1, size, file) != size)
+        return IO_READ_ERR;
+    return 0;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef C_STRING_INDEX_H
+#define C_STRING_INDEX_H
+
+#include "c_string.h"
+
+#define MY_STR_INDEX_FM 1              // keeps FM-index instead of the text and its suffix array
+#define MY_STR_INDEX_OCC_STEP 128      // FM-index: occurrences are counted before every such row
+#define MY_STR_INDEX_SAMPLE_STEP 32    // FM-index: suffix array is kept for every such text position
+
+/*
+ * full text index for many searches in the same unchanging text
+ * without flags it keeps copy of the text and its suffix array (9 bytes per symbol on 64 bit),
+ * queries take O(m log n) for pattern of m symbols
+ * with MY_STR_INDEX_FM it keeps Burrows-Wheeler transform, occurrence counts and sampled
+ * suffix array (from about 1.5 bytes per symbol for DNA-like texts to about 9 for texts that use
+ * all 256 bytes, occurrence counts take 4 * sigma / MY_STR_INDEX_OCC_STEP bytes per symbol),
+ * count takes O(m), every located position
+ * takes at most MY_STR_INDEX_SAMPLE_STEP more steps; text is limited by UINT32_MAX symbols
+ */
+typedef struct {
+    int flags;
+    size_t size_m;              // size of indexed text
+    // suffix array mode
+    my_str_t text;              // copy of indexed text
+    size_t *sa;                 // size_m + 1 suffixes in sorted order, sa[0] is the empty one
+    // FM-index mode
+    unsigned char *bwt;         // size_m + 1 symbols of transform, bwt[primary] is the end of text
+    size_t primary;             // row of the suffix that is the whole text
+    size_t counts[257];         // number of rows that start with symbol smaller than c
+    int16_t codes[256];         // dense code of every byte of the text, -1 for absent bytes
+    size_t sigma;               // number of different bytes in text
+    uint32_t *occ;              // occurrences of every code before every MY_STR_INDEX_OCC_STEP-th row
+    uint64_t *marks;            // bit for every row whose text position is sampled
+    uint32_t *mark_ranks;       // number of marked rows before every word of marks
+    uint32_t *samples;          // text positions of marked rows in order of rows
+} my_str_index_t;
+
+/*
+ * builds index of the text with SA-IS algorithm in linear time
+ * text is copied (suffix array mode) or not needed anymore (FM-index mode)
+ * flags: MY_STR_INDEX_FM or 0
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index or text is NULL
+ *      RANGE_ERR if text is too large for FM-index
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_index_build(my_str_index_t* index, const my_str_t* text, int flags);
+
+/*
+ * frees all data of the index
+ * return:
+ *     0 always
+ */
+int my_str_index_free(my_str_index_t* index);
+
+/*
+ * counts occurrences of the pattern in the text, empty pattern never occurs
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index or count is NULL
+ */
+int my_str_index_count(const my_str_index_t* index, my_str_view_t pattern, size_t* count);
+
+/*
+ * finds the first occurrence of the pattern like my_str_find, but every occurrence is looked at
+ * return:
+ *      0  if OK
+ *      NOT_FOUND_CODE if there is no such pattern in text
+ *      NULL_PTR_ERR if index or pos is NULL
+ */
+int my_str_index_find(const my_str_index_t* index, my_str_view_t pattern, size_t* pos);
+
+/*
+ * saves positions of occurrences of the pattern in increasing order
+ * if there are more than max occurrences, only some max of them are saved
+ * count: if not NULL, number of all occurrences is saved there
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index is NULL or positions is NULL and max is not 0
+ */
+int my_str_index_locate(const my_str_index_t* index, my_str_view_t pattern,
+                        size_t* positions, size_t max, size_t* count);
+
+/*
+ * returns number of bytes allocated by the index
+ * if index == NULL than memory = 0
+ */
+size_t my_str_index_memory(const my_str_index_t* index);
+
+/*
+ * writes index to binary file, so it can be loaded without building again
+ * file is in byte order of this machine
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index or file is NULL
+ *      IO_WRITE_ERR if error occurred while writing
+ */
+int my_str_index_save(const my_str_index_t* index, FILE* file);
+
+/*
+ * reads index written by my_str_index_save
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if index or file is NULL
+ *      IO_READ_ERR if file can not be read or it is not a saved index
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_index_load(my_str_index_t* index, FILE* file);
+
+#endif // C_STRING_INDEX_H
@@ -0,0 +1,326 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_intern.h"
+
+static my_str_intern_shard_t* shard_of(my_str_intern_t* table, uint64_t hash, size_t* shard_index);
+static void shard_lock(my_str_intern_t* table, my_str_intern_shard_t* shard);
+static void shard_unlock(my_str_intern_t* table, my_str_intern_shard_t* shard);
+static size_t shard_lookup(const my_str_intern_shard_t* shard, my_str_view_t str, uint64_t hash);
+static int shard_add(my_str_intern_shard_t* shard, my_str_view_t str, uint64_t hash, size_t* local);
+static int shard_grow_index(my_str_intern_shard_t* shard);
+static void shard_free(my_str_intern_shard_t* shard);
+
+/*
+ * creates empty table
+ * concurrent: if not 0, table can be used from many threads at once, every shard is locked separately
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_intern_create(my_str_intern_t* table, int concurrent) {
+    if (!table)
+        return NULL_PTR_ERR;
+
+    table->concurrent = concurrent ? 1 : 0;
+    table->shards_count = concurrent ? MY_STR_INTERN_SHARDS : 1;
+    table->shards = (my_str_intern_shard_t *) calloc(table->shards_count, sizeof(my_str_intern_shard_t));
+    if (!table->shards)
+        return MEMORY_ALLOCATION_ERR;
+
+    for (size_t i = 0; i < table->shards_count && concurrent; i++) {
+        if (pthread_mutex_init(&table->shards[i].lock, NULL) != 0) {
+            for (size_t j = 0; j < i; j++)
+                pthread_mutex_destroy(&table->shards[j].lock);
+            free(table->shards);
+            table->shards = NULL;
+            return MEMORY_ALLOCATION_ERR;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * frees table and all interned strings
+ * return:
+ *     0 always
+ */
+int my_str_intern_free(my_str_intern_t* table) {
+    if (!table || !table->shards)
+        return 0;
+
+    for (size_t i = 0; i < table->shards_count; i++) {
+        shard_free(&table->shards[i]);
+        if (table->concurrent)
+            pthread_mutex_destroy(&table->shards[i].lock);
+    }
+
+    free(table->shards);
+    table->shards = NULL;
+    table->shards_count = 0;
+
+    return 0;
+}
+
+/*
+ * returns canonical copy of given string, interning it if it is met for the first time
+ * canonical, id: if not NULL, canonical copy and its id are saved there
+ * return:
+ *      0  if string was interned now
+ *      1  if string was already interned
+ *      NULL_PTR_ERR if table is NULL or str has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_intern(my_str_intern_t* table, my_str_view_t str, my_str_view_t* canonical, size_t* id) {
+    if (!table || !table->shards || (!str.data && str.size_m))
+        return NULL_PTR_ERR;
+
+    uint64_t hash = my_str_hash_view(str, 0);
+    size_t shard_index;
+    my_str_intern_shard_t* shard = shard_of(table, hash, &shard_index);
+
+    shard_lock(table, shard);
+    int result = 1;
+    size_t local = shard_lookup(shard, str, hash);
+    if (local == SIZE_MAX)
+        result = shard_add(shard, str, hash, &local);
+
+    if (result >= 0) {
+        if (canonical) {
+            canonical->data = shard->entries[local].data;
+            canonical->size_m = shard->entries[local].size_m;
+        }
+        if (id) *id = local * table->shards_count + shard_index;
+    }
+    shard_unlock(table, shard);
+
+    return result;
+}
+
+/*
+ * looks for already interned string, nothing is interned
+ * return:
+ *      0  if string is found
+ *      NOT_FOUND_CODE if string was not interned
+ *      NULL_PTR_ERR if table is NULL
+ */
+int my_str_intern_find(my_str_intern_t* table, my_str_view_t str, my_str_view_t* canonical, size_t* id) {
+    if (!table || !table->shards)
+        return NULL_PTR_ERR;
+
+    uint64_t hash = my_str_hash_view(str, 0);
+    size_t shard_index;
+    my_str_intern_shard_t* shard = shard_of(table, hash, &shard_index);
+
+    shard_lock(table, shard);
+    size_t local = shard_lookup(shard, str, hash);
+    if (local != SIZE_MAX) {
+        if (canonical) {
+            canonical->data = shard->entries[local].data;
+            canonical->size_m = shard->entries[local].size_m;
+        }
+        if (id) *id = local * table->shards_count + shard_index;
+    }
+    shard_unlock(table, shard);
+
+    return (local == SIZE_MAX) ? NOT_FOUND_CODE : 0;
+}
+
+/*
+ * returns canonical copy of interned string by its id
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or canonical is NULL
+ *      RANGE_ERR if there is no string with such id
+ */
+int my_str_intern_get(my_str_intern_t* table, size_t id, my_str_view_t* canonical) {
+    if (!table || !table->shards || !canonical)
+        return NULL_PTR_ERR;
+
+    my_str_intern_shard_t* shard = &table->shards[id % table->shards_count];
+    size_t local = id / table->shards_count;
+
+    int err = RANGE_ERR;
+    shard_lock(table, shard);
+    if (local < shard->count) {
+        canonical->data = shard->entries[local].data;
+        canonical->size_m = shard->entries[local].size_m;
+        err = 0;
+    }
+    shard_unlock(table, shard);
+
+    return err;
+}
+
+/*
+ * returns number of interned strings
+ * if table == NULL than count = 0
+ */
+size_t my_str_intern_count(my_str_intern_t* table) {
+    if (!table || !table->shards)
+        return 0;
+
+    size_t count = 0;
+    for (size_t i = 0; i < table->shards_count; i++) {
+        shard_lock(table, &table->shards[i]);
+        count += table->shards[i].count;
+        shard_unlock(table, &table->shards[i]);
+    }
+
+    return count;
+}
+
+/*
+ * returns number of bytes allocated by the table (blocks, entries and indexes)
+ * if table == NULL than memory = 0
+ */
+size_t my_str_intern_memory(my_str_intern_t* table) {
+    if (!table || !table->shards)
+        return 0;
+
+    size_t memory = table->shards_count * sizeof(my_str_intern_shard_t);
+    for (size_t i = 0; i < table->shards_count; i++) {
+        shard_lock(table, &table->shards[i]);
+        memory += table->shards[i].memory;
+        shard_unlock(table, &table->shards[i]);
+    }
+
+    return memory;
+}
+
+// top bits of hash choose the shard, low bits are used by its index
+static my_str_intern_shard_t* shard_of(my_str_intern_t* table, uint64_t hash, size_t* shard_index) {
+    *shard_index = (size_t) (hash >> 60) & (table->shards_count - 1);
+    return &table->shards[*shard_index];
+}
+
+static void shard_lock(my_str_intern_t* table, my_str_intern_shard_t* shard) {
+    if (table->concurrent)
+        pthread_mutex_lock(&shard->lock);
+}
+
+static void shard_unlock(my_str_intern_t* table, my_str_intern_shard_t* shard) {
+    if (table->concurrent)
+        pthread_mutex_unlock(&shard->lock);
+}
+
+// returns local id of the string or SIZE_MAX
+static size_t shard_lookup(const my_str_intern_shard_t* shard, my_str_view_t str, uint64_t hash) {
+    if (!shard->index_capacity)
+        return SIZE_MAX;
+
+    size_t mask = shard->index_capacity - 1;
+    for (size_t i = (size_t) hash & mask;; i = (i + 1) & mask) {
+        uint32_t slot = shard->index[i];
+        if (!slot)
+            return SIZE_MAX;
+
+        const my_str_intern_entry_t* entry = &shard->entries[slot - 1];
+        if (entry->hash == hash && entry->size_m == str.size_m &&
+            (str.size_m == 0 || memcmp(entry->data, str.data, str.size_m) == 0))
+            return slot - 1;
+    }
+}
+
+// copies string into the block storage and adds it to the index
+static int shard_add(my_str_intern_shard_t* shard, my_str_view_t str, uint64_t hash, size_t* local) {
+    if (shard->count >= UINT32_MAX - 1 || str.size_m > SIZE_MAX - MY_STR_INTERN_BLOCK)
+        return MEMORY_ALLOCATION_ERR;
+
+    // keeps index at most half full
+    if ((shard->count + 1) * 2 > shard->index_capacity) {
+        int err = shard_grow_index(shard);
+        if (err != 0) return err;
+    }
+
+    if (shard->count == shard->entries_capacity) {
+        size_t capacity = shard->entries_capacity ? shard->entries_capacity * 2 : 16;
+        my_str_intern_entry_t* entries = (my_str_intern_entry_t *)
+                realloc(shard->entries, capacity * sizeof(my_str_intern_entry_t));
+        if (!entries)
+            return MEMORY_ALLOCATION_ERR;
+        shard->memory += (capacity - shard->entries_capacity) * sizeof(my_str_intern_entry_t);
+        shard->entries = entries;
+        shard->entries_capacity = capacity;
+    }
+
+    // strings are never moved, so a new block is started when the current one is full
+    if (!shard->blocks_count || str.size_m + 1 > shard->block_size - shard->block_used) {
+        if (shard->blocks_count == shard->blocks_capacity) {
+            size_t capacity = shard->blocks_capacity ? shard->blocks_capacity * 2 : 4;
+            char** blocks = (char **) realloc(shard->blocks, capacity * sizeof(char *));
+            if (!blocks)
+                return MEMORY_ALLOCATION_ERR;
+            shard->memory += (capacity - shard->blocks_capacity) * sizeof(char *);
+            shard->blocks = blocks;
+            shard->blocks_capacity = capacity;
+        }
+
+        size_t block_size = (str.size_m + 1 > MY_STR_INTERN_BLOCK) ? str.size_m + 1 : MY_STR_INTERN_BLOCK;
+        char* block = (char *) malloc(block_size);
+        if (!block)
+            return MEMORY_ALLOCATION_ERR;
+        shard->memory += block_size;
+        shard->blocks[shard->blocks_count++] = block;
+        shard->block_size = block_size;
+        shard->block_used = 0;
+    }
+
+    char* data = shard->blocks[shard->blocks_count - 1] + shard->block_used;
+    if (str.size_m)
+        memcpy(data, str.data, str.size_m);
+    data[str.size_m] = '\0';
+    shard->block_used += str.size_m + 1;
+
+    my_str_intern_entry_t* entry = &shard->entries[shard->count];
+    entry->data = data;
+    entry->size_m = str.size_m;
+    entry->hash = hash;
+
+    size_t mask = shard->index_capacity - 1;
+    size_t i = (size_t) hash & mask;
+    while (shard->index[i])
+        i = (i + 1) & mask;
+    shard->index[i] = (uint32_t) (shard->count + 1);
+
+    *local = shard->count++;
+    return 0;
+}
+
+// doubles the index and puts all entries into it again
+static int shard_grow_index(my_str_intern_shard_t* shard) {
+    size_t capacity = shard->index_capacity ? shard->index_capacity * 2 : 32;
+    uint32_t* index = (uint32_t *) calloc(capacity, sizeof(uint32_t));
+    if (!index)
+        return MEMORY_ALLOCATION_ERR;
+
+    size_t mask = capacity - 1;
+    for (size_t id = 0; id < shard->count; id++) {
+        size_t i = (size_t) shard->entries[id].hash & mask;
+        while (index[i])
+            i = (i + 1) & mask;
+        index[i] = (uint32_t) (id + 1);
+    }
+
+    free(shard->index);
+    shard->memory += (capacity - shard->index_capacity) * sizeof(uint32_t);
+    shard->index = index;
+    shard->index_capacity = capacity;
+
+    return 0;
+}
+
+static void shard_free(my_str_intern_shard_t* shard) {
+    for (size_t i = 0; i < shard->blocks_count; i++)
+        free(shard->blocks[i]);
+
+    free(shard->blocks);
+    free(shard->entries);
+    free(shard->index);
+    shard->blocks = NULL;
+    shard->entries = NULL;
+    shard->index = NULL;
+    shard->count = shard->blocks_count = shard->index_capacity = 0;
+    shard->memory = 0;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#ifndef C_STRING_INTERN_H
+#define C_STRING_INTERN_H
+
+#include <pthread.h>
+
+#include "c_string.h"
+
+#define MY_STR_INTERN_SHARDS 16        // number of independently locked parts in concurrent mode
+#define MY_STR_INTERN_BLOCK (1 << 16)  // size of blocks that keep bytes of interned strings
+
+// interned string, data is null terminated and never moves
+typedef struct {
+    const char *data;
+    size_t size_m;
+    uint64_t hash;
+} my_str_intern_entry_t;
+
+// part of the table with its own entries, index and lock
+typedef struct {
+    my_str_intern_entry_t *entries; // indexed by local id
+    size_t count;
+    size_t entries_capacity;
+    uint32_t *index;                // open addressing, local id + 1 or 0 if empty
+    size_t index_capacity;          // power of two
+    char **blocks;                  // all allocated blocks, the last one is being filled
+    size_t blocks_count;
+    size_t blocks_capacity;
+    size_t block_used;              // bytes used in the last block
+    size_t block_size;              // size of the last block
+    size_t memory;                  // bytes allocated by the shard
+    pthread_mutex_t lock;
+} my_str_intern_shard_t;
+
+/*
+ * table that maps string content to a single canonical copy and a stable id
+ * interned strings are equal if and only if their canonical data pointers (or ids) are equal
+ */
+typedef struct {
+    my_str_intern_shard_t *shards;
+    size_t shards_count;            // 1, or MY_STR_INTERN_SHARDS in concurrent mode
+    int concurrent;
+} my_str_intern_t;
+
+/*
+ * creates empty table
+ * concurrent: if not 0, table can be used from many threads at once, every shard is locked separately
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_intern_create(my_str_intern_t* table, int concurrent);
+
+/*
+ * frees table and all interned strings
+ * return:
+ *     0 always
+ */
+int my_str_intern_free(my_str_intern_t* table);
+
+/*
+ * returns canonical copy of given string, interning it if it is met for the first time
+ * canonical, id: if not NULL, canonical copy and its id are saved there
+ * return:
+ *      0  if string was interned now
+ *      1  if string was already interned
+ *      NULL_PTR_ERR if table is NULL or str has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_intern(my_str_intern_t* table, my_str_view_t str, my_str_view_t* canonical, size_t* id);
+
+/*
+ * looks for already interned string, nothing is interned
+ * return:
+ *      0  if string is found
+ *      NOT_FOUND_CODE if string was not interned
+ *      NULL_PTR_ERR if table is NULL
+ */
+int my_str_intern_find(my_str_intern_t* table, my_str_view_t str, my_str_view_t* canonical, size_t* id);
+
+/*
+ * returns canonical copy of interned string by its id
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or canonical is NULL
+ *      RANGE_ERR if there is no string with such id
+ */
+int my_str_intern_get(my_str_intern_t* table, size_t id, my_str_view_t* canonical);
+
+/*
+ * returns number of interned strings
+ * if table == NULL than count = 0
+ */
+size_t my_str_intern_count(my_str_intern_t* table);
+
+/*
+ * returns number of bytes allocated by the table (blocks, entries and indexes)
+ * if table == NULL than memory = 0
+ */
+size_t my_str_intern_memory(my_str_intern_t* table);
+
+#endif // C_STRING_INTERN_H
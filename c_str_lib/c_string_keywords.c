@@ -0,0 +1,190 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_keywords.h"
+
+static size_t power_of_two_at_least(size_t n);
+static int place_bucket(my_str_kw_table_t* table, int32_t* slots, const size_t* keys, size_t size,
+                        const uint64_t* hashes, uint32_t* displacement);
+
+/*
+ * builds table for given keywords, id of every keyword is its index in the array
+ * keywords are not copied, they must live as long as the table
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or keywords (or one of them) is NULL
+ *      RANGE_ERR if keywords repeat or there are more than INT32_MAX of them
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_kw_create(my_str_kw_table_t* table, const char* const* keywords, size_t count) {
+    if (!table || (!keywords && count))
+        return NULL_PTR_ERR;
+
+    if (count > INT32_MAX)
+        return RANGE_ERR;
+
+    for (size_t i = 0; i < count; i++)
+        if (!keywords[i])
+            return NULL_PTR_ERR;
+
+    size_t capacity = power_of_two_at_least(count * 2);
+    size_t buckets = power_of_two_at_least(count);
+
+    // sizes, displacements and slots are kept in a single block
+    char* memory = (char *) malloc(count * sizeof(size_t) + buckets * sizeof(uint32_t) + capacity * sizeof(int32_t));
+    // hashes, keys grouped by bucket and starts of the groups are needed only while building
+    char* temp = (char *) malloc(count * (sizeof(uint64_t) + sizeof(size_t)) + (buckets + 1) * sizeof(size_t));
+    if (!memory || !temp) {
+        free(memory);
+        free(temp);
+        return MEMORY_ALLOCATION_ERR;
+    }
+
+    size_t* sizes = (size_t *) memory;
+    uint32_t* displacements = (uint32_t *) (sizes + count);
+    int32_t* slots = (int32_t *) (displacements + buckets);
+    uint64_t* hashes = (uint64_t *) temp;
+    size_t* keys = (size_t *) (hashes + count);
+    size_t* starts = keys + count;
+
+    table->keywords = keywords;
+    table->sizes = sizes;
+    table->slots = slots;
+    table->displacements = displacements;
+    table->count = count;
+    table->capacity = capacity;
+    table->buckets = buckets;
+    table->memory = memory;
+
+    memset(displacements, 0, buckets * sizeof(uint32_t));
+    for (size_t i = 0; i < capacity; i++)
+        slots[i] = -1;
+
+    // keys are grouped by their bucket with counting sort
+    memset(starts, 0, (buckets + 1) * sizeof(size_t));
+    size_t largest = 0;
+    for (size_t i = 0; i < count; i++) {
+        sizes[i] = strlen(keywords[i]);
+        hashes[i] = my_str_kw_hash(keywords[i], sizes[i]);
+        size_t bucket = (size_t) (hashes[i] >> 32) & (buckets - 1);
+        if (++starts[bucket + 1] > largest)
+            largest = starts[bucket + 1];
+    }
+    for (size_t b = 0; b < buckets; b++)
+        starts[b + 1] += starts[b];
+    for (size_t i = 0; i < count; i++) {
+        size_t bucket = (size_t) (hashes[i] >> 32) & (buckets - 1);
+        keys[starts[bucket]++] = i;
+    }
+    for (size_t b = buckets; b > 0; b--)
+        starts[b] = starts[b - 1];
+    starts[0] = 0;
+
+    // larger buckets are placed first, while there are many free slots
+    int err = 0;
+    for (size_t size = largest; size > 0 && err == 0; size--) {
+        for (size_t b = 0; b < buckets && err == 0; b++) {
+            if (starts[b + 1] - starts[b] == size)
+                err = place_bucket(table, slots, keys + starts[b], size, hashes, &displacements[b]);
+        }
+    }
+
+    free(temp);
+    if (err != 0)
+        my_str_kw_free(table);
+
+    return err;
+}
+
+/*
+ * frees memory of table built by my_str_kw_create
+ * return:
+ *     0 always
+ */
+int my_str_kw_free(my_str_kw_table_t* table) {
+    if (!table)
+        return 0;
+
+    free(table->memory);
+    table->memory = NULL;
+    table->sizes = NULL;
+    table->slots = NULL;
+    table->displacements = NULL;
+    table->count = 0;
+
+    return 0;
+}
+
+/*
+ * returns id of keyword equal to the token
+ * return:
+ *      id of keyword (0 or greater) if found
+ *      NOT_FOUND_CODE if token is not a keyword
+ *      NULL_PTR_ERR if table is NULL
+ */
+int my_str_kw_match(const my_str_kw_table_t* table, my_str_view_t token) {
+    if (!table || !table->slots)
+        return NULL_PTR_ERR;
+
+    if (!token.data && token.size_m)
+        return NOT_FOUND_CODE;
+
+    uint64_t hash = my_str_kw_hash(token.data, token.size_m);
+    uint32_t displacement = table->displacements[(size_t) (hash >> 32) & (table->buckets - 1)];
+    int32_t id = table->slots[my_str_kw_slot(hash, displacement, table->capacity)];
+
+    if (id < 0 || table->sizes[id] != token.size_m ||
+        (token.size_m && memcmp(table->keywords[id], token.data, token.size_m) != 0))
+        return NOT_FOUND_CODE;
+
+    return id;
+}
+
+/*
+ * the same as my_str_kw_match for my_str-string
+ * return:
+ *      the same as in my_str_kw_match, NULL_PTR_ERR if str is NULL too
+ */
+int my_str_kw_match_str(const my_str_kw_table_t* table, const my_str_t* str) {
+    if (!str)
+        return NULL_PTR_ERR;
+
+    return my_str_kw_match(table, my_str_view(str));
+}
+
+static size_t power_of_two_at_least(size_t n) {
+    size_t result = 1;
+    while (result < n)
+        result *= 2;
+    return result;
+}
+
+// looks for displacement that puts all keys of the bucket to free slots
+static int place_bucket(my_str_kw_table_t* table, int32_t* slots, const size_t* keys, size_t size,
+                        const uint64_t* hashes, uint32_t* displacement) {
+    // keys with equal hashes can not get different slots
+    for (size_t i = 0; i < size; i++)
+        for (size_t j = i + 1; j < size; j++)
+            if (hashes[keys[i]] == hashes[keys[j]])
+                return RANGE_ERR;
+
+    for (uint32_t d = 0; d < MY_STR_KW_MAX_DISPLACEMENT; d++) {
+        size_t placed = 0;
+        for (; placed < size; placed++) {
+            size_t slot = my_str_kw_slot(hashes[keys[placed]], d, table->capacity);
+            if (slots[slot] >= 0)
+                break;
+            slots[slot] = (int32_t) keys[placed];
+        }
+
+        if (placed == size) {
+            *displacement = d;
+            return 0;
+        }
+
+        // the keys placed with this displacement are taken back
+        for (size_t i = 0; i < placed; i++)
+            slots[my_str_kw_slot(hashes[keys[i]], d, table->capacity)] = -1;
+    }
+
+    return RANGE_ERR;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#ifndef C_STRING_KEYWORDS_H
+#define C_STRING_KEYWORDS_H
+
+#include "c_string.h"
+
+#define MY_STR_KW_MAX_DISPLACEMENT (1u << 20) // builder gives up on a bucket after so many tries
+
+// FNV-1a is used, so the same hash can be computed by constexpr functions of c_string_keywords.hpp
+#define MY_STR_KW_FNV_OFFSET 0xcbf29ce484222325ull
+#define MY_STR_KW_FNV_PRIME 0x100000001b3ull
+#define MY_STR_KW_GOLDEN 0x9e3779b97f4a7c15ull
+
+/*
+ * keyword lists are declared once as X-macros and expanded both to ids and to texts:
+ *     #define HTTP_METHODS(X) X(HTTP_GET, "GET") X(HTTP_PUT, "PUT") X(HTTP_DELETE, "DELETE")
+ *     enum { HTTP_METHODS(MY_STR_KW_ID) HTTP_METHODS_COUNT };
+ *     static const char* const http_methods[] = { HTTP_METHODS(MY_STR_KW_TEXT) };
+ * than my_str_kw_create(&table, http_methods, HTTP_METHODS_COUNT) gives table that matches ids of enum
+ */
+#define MY_STR_KW_ID(id, text) id,
+#define MY_STR_KW_TEXT(id, text) text,
+
+/*
+ * perfect hash table of a fixed keyword set: first level hash chooses a bucket, displacement of
+ * the bucket chooses the slot, so every keyword has its own slot and only one compare is needed
+ * all arrays are read only after building, so table can be used from many threads at once
+ */
+typedef struct {
+    const char* const *keywords;    // keyword texts, index is keyword id
+    const size_t *sizes;            // lengths of keywords
+    const int32_t *slots;           // keyword id or -1, capacity elements
+    const uint32_t *displacements;  // buckets elements
+    size_t count;                   // number of keywords
+    size_t capacity;                // power of two, at least twice larger than count
+    size_t buckets;                 // power of two
+    void *memory;                   // memory allocated by my_str_kw_create, NULL for constexpr tables
+} my_str_kw_table_t;
+
+// first level hash of the token, also used to choose the bucket
+static inline uint64_t my_str_kw_hash(const char* data, size_t size) {
+    uint64_t hash = MY_STR_KW_FNV_OFFSET;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ (unsigned char) data[i]) * MY_STR_KW_FNV_PRIME;
+    return hash;
+}
+
+// slot of the token with given first level hash in the bucket with given displacement
+static inline size_t my_str_kw_slot(uint64_t hash, uint32_t displacement, size_t capacity) {
+    uint64_t x = hash + displacement * MY_STR_KW_GOLDEN;
+    x = (x ^ (x >> 33)) * 0xff51afd7ed558ccdull;
+    x = (x ^ (x >> 33)) * 0xc4ceb9fe1a85ec53ull;
+    return (size_t) (x ^ (x >> 33)) & (capacity - 1);
+}
+
+/*
+ * builds table for given keywords, id of every keyword is its index in the array
+ * keywords are not copied, they must live as long as the table
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or keywords (or one of them) is NULL
+ *      RANGE_ERR if keywords repeat or there are more than INT32_MAX of them
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_kw_create(my_str_kw_table_t* table, const char* const* keywords, size_t count);
+
+/*
+ * frees memory of table built by my_str_kw_create
+ * return:
+ *     0 always
+ */
+int my_str_kw_free(my_str_kw_table_t* table);
+
+/*
+ * returns id of keyword equal to the token
+ * return:
+ *      id of keyword (0 or greater) if found
+ *      NOT_FOUND_CODE if token is not a keyword
+ *      NULL_PTR_ERR if table is NULL
+ */
+int my_str_kw_match(const my_str_kw_table_t* table, my_str_view_t token);
+
+/*
+ * the same as my_str_kw_match for my_str-string
+ * return:
+ *      the same as in my_str_kw_match, NULL_PTR_ERR if str is NULL too
+ */
+int my_str_kw_match_str(const my_str_kw_table_t* table, const my_str_t* str);
+
+#endif // C_STRING_KEYWORDS_H
@@ -0,0 +1,171 @@
+#pragma once
+#ifndef C_STRING_KEYWORDS_HPP
+#define C_STRING_KEYWORDS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+extern "C" {
+#include "c_string_keywords.h"
+}
+
+/*
+ * compile time version of my_str_kw_create, tables are the same as built in runtime
+ *     static constexpr const char* methods[] = {"GET", "PUT", "DELETE"};
+ *     static constexpr auto table = my_str::make_keyword_table(methods);
+ *     switch (table.match(token)) {
+ *         case table.id_of("GET"): ...
+ *     }
+ * requires C++14
+ */
+namespace my_str {
+    constexpr uint64_t kw_hash(const char* data, size_t size) {
+        uint64_t hash = MY_STR_KW_FNV_OFFSET;
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * MY_STR_KW_FNV_PRIME;
+        return hash;
+    }
+
+    constexpr size_t kw_slot(uint64_t hash, uint32_t displacement, size_t capacity) {
+        uint64_t x = hash + displacement * MY_STR_KW_GOLDEN;
+        x = (x ^ (x >> 33)) * 0xff51afd7ed558ccdull;
+        x = (x ^ (x >> 33)) * 0xc4ceb9fe1a85ec53ull;
+        return static_cast<size_t>(x ^ (x >> 33)) & (capacity - 1);
+    }
+
+    constexpr size_t kw_power_of_two_at_least(size_t n) {
+        size_t result = 1;
+        while (result < n)
+            result *= 2;
+        return result;
+    }
+
+    constexpr size_t kw_length(const char* cstr) {
+        size_t size = 0;
+        while (cstr[size])
+            size++;
+        return size;
+    }
+
+    template <size_t N>
+    class keyword_table {
+    public:
+        static constexpr size_t capacity = kw_power_of_two_at_least(N * 2);
+        static constexpr size_t buckets = kw_power_of_two_at_least(N);
+
+        // the same algorithm as in my_str_kw_create, so the same displacements are found
+        constexpr explicit keyword_table(const char* const (&keywords)[N])
+                : keywords_{}, sizes_{}, slots_{}, displacements_{} {
+            uint64_t hashes[N] = {};
+            size_t bucket_sizes[buckets] = {};
+            size_t largest = 0;
+            for (size_t i = 0; i < N; i++) {
+                keywords_[i] = keywords[i];
+                sizes_[i] = kw_length(keywords[i]);
+                hashes[i] = kw_hash(keywords[i], sizes_[i]);
+                size_t bucket = bucket_of(hashes[i]);
+                if (++bucket_sizes[bucket] > largest)
+                    largest = bucket_sizes[bucket];
+            }
+            for (size_t i = 0; i < capacity; i++)
+                slots_[i] = -1;
+
+            for (size_t size = largest; size > 0; size--) {
+                for (size_t b = 0; b < buckets; b++) {
+                    if (bucket_sizes[b] != size)
+                        continue;
+
+                    // keys of the bucket in order of their ids, like after counting sort
+                    size_t keys[N] = {};
+                    size_t count = 0;
+                    for (size_t i = 0; i < N; i++)
+                        if (bucket_of(hashes[i]) == b)
+                            keys[count++] = i;
+
+                    for (size_t i = 0; i < count; i++)
+                        for (size_t j = i + 1; j < count; j++)
+                            if (hashes[keys[i]] == hashes[keys[j]])
+                                throw std::invalid_argument("keywords repeat");
+
+                    displacements_[b] = place(keys, count, hashes);
+                }
+            }
+        }
+
+        // id of keyword or NOT_FOUND_CODE, the same as my_str_kw_match
+        int match(my_str_view_t token) const {
+            my_str_kw_table_t c_table = table();
+            return my_str_kw_match(&c_table, token);
+        }
+
+        int match(const my_str_t* str) const {
+            my_str_kw_table_t c_table = table();
+            return my_str_kw_match_str(&c_table, str);
+        }
+
+        // id of keyword known at compile time, so it can be used in case labels
+        template <size_t M>
+        constexpr int id_of(const char (&keyword)[M]) const {
+            uint64_t hash = kw_hash(keyword, M - 1);
+            int32_t id = slots_[kw_slot(hash, displacements_[bucket_of(hash)], capacity)];
+            if (id < 0 || sizes_[id] != M - 1)
+                return NOT_FOUND_CODE;
+            for (size_t i = 0; i < M - 1; i++)
+                if (keywords_[id][i] != keyword[i])
+                    return NOT_FOUND_CODE;
+            return id;
+        }
+
+        // table for C functions, valid while this object lives
+        my_str_kw_table_t table() const {
+            my_str_kw_table_t c_table{};
+            c_table.keywords = keywords_;
+            c_table.sizes = sizes_;
+            c_table.slots = slots_;
+            c_table.displacements = displacements_;
+            c_table.count = N;
+            c_table.capacity = capacity;
+            c_table.buckets = buckets;
+            c_table.memory = nullptr;
+            return c_table;
+        }
+
+    private:
+        const char* keywords_[N];
+        size_t sizes_[N];
+        int32_t slots_[capacity];
+        uint32_t displacements_[buckets];
+
+        static constexpr size_t bucket_of(uint64_t hash) {
+            return static_cast<size_t>(hash >> 32) & (buckets - 1);
+        }
+
+        constexpr uint32_t place(const size_t* keys, size_t count, const uint64_t* hashes) {
+            for (uint32_t d = 0; d < MY_STR_KW_MAX_DISPLACEMENT; d++) {
+                size_t placed = 0;
+                for (; placed < count; placed++) {
+                    size_t slot = kw_slot(hashes[keys[placed]], d, capacity);
+                    if (slots_[slot] >= 0)
+                        break;
+                    slots_[slot] = static_cast<int32_t>(keys[placed]);
+                }
+
+                if (placed == count)
+                    return d;
+
+                for (size_t i = 0; i < placed; i++)
+                    slots_[kw_slot(hashes[keys[i]], d, capacity)] = -1;
+            }
+
+            throw std::invalid_argument("no displacement found");
+        }
+    };
+
+    template <size_t N>
+    constexpr keyword_table<N> make_keyword_table(const char* const (&keywords)[N]) {
+        return keyword_table<N>(keywords);
+    }
+}
+
+#endif // C_STRING_KEYWORDS_HPP
@@ -0,0 +1,147 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_loader.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// state shared by all workers of one my_str_read_files call
+typedef struct {
+    my_str_t* strs;
+    const char* const* paths;
+    int* errors;
+    size_t count;
+    size_t next;          // index of the next file to be taken by a worker
+    size_t failed;        // number of files that were not loaded
+    size_t max_inflight;
+    size_t inflight;      // bytes that are being read right now
+    pthread_mutex_t lock;
+    pthread_cond_t budget_freed;
+} loader_t;
+
+static int load_one(loader_t* loader, size_t index);
+static void* loader_worker(void* arg);
+
+/*
+ * loads given files into array of my_str-strings concurrently, using pool of worker threads
+ * every file is read with my_str_read_fd, so its buffer is reserved for the whole file at once
+ * strs: array of count strings, each created with my_str_create
+ * paths: array of count paths, strs[i] gets content of paths[i]
+ * threads: number of worker threads; if 0 then number of online CPUs is used
+ * max_inflight: upper bound of bytes that are being read at the same time, 0 means no bound;
+ *      a file that is bigger than the bound is read when nothing else is in flight
+ * errors: array of count result codes (may be NULL), errors[i] is set to
+ *      0 if paths[i] was loaded
+ *      NULL_PTR_ERR if paths[i] is NULL
+ *      IO_READ_ERR if file can not be opened or read
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ * return:
+ *      0  if all files were loaded
+ *      NULL_PTR_ERR if strs or paths is NULL
+ *      IO_READ_ERR if at least one file was not loaded (see errors)
+ */
+int my_str_read_files(my_str_t* strs, const char* const* paths, size_t count,
+                      size_t threads, size_t max_inflight, int* errors) {
+    if (!strs || !paths)
+        return NULL_PTR_ERR;
+
+    if (count == 0)
+        return 0;
+
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (size_t) cpus : 1;
+    }
+    threads = (threads < count) ? threads : count;
+
+    loader_t loader = {0};
+    loader.strs = strs;
+    loader.paths = paths;
+    loader.errors = errors;
+    loader.count = count;
+    loader.max_inflight = max_inflight;
+    if (pthread_mutex_init(&loader.lock, NULL) != 0)
+        return MEMORY_ALLOCATION_ERR;
+    if (pthread_cond_init(&loader.budget_freed, NULL) != 0) {
+        pthread_mutex_destroy(&loader.lock);
+        return MEMORY_ALLOCATION_ERR;
+    }
+
+    // the calling thread is one of the workers, so at most threads - 1 are started
+    pthread_t* workers = (threads > 1) ? (pthread_t *) malloc((threads - 1) * sizeof(pthread_t)) : NULL;
+    size_t started = 0;
+    for (; workers && started < threads - 1; started++)
+        if (pthread_create(&workers[started], NULL, loader_worker, &loader) != 0)
+            break;
+
+    loader_worker(&loader);
+
+    for (size_t i = 0; i < started; i++)
+        pthread_join(workers[i], NULL);
+
+    free(workers);
+    pthread_cond_destroy(&loader.budget_freed);
+    pthread_mutex_destroy(&loader.lock);
+
+    return loader.failed ? IO_READ_ERR : 0;
+}
+
+// takes files one by one until none is left
+static void* loader_worker(void* arg) {
+    loader_t* loader = (loader_t *) arg;
+
+    for (;;) {
+        pthread_mutex_lock(&loader->lock);
+        size_t index = loader->next++;
+        pthread_mutex_unlock(&loader->lock);
+        if (index >= loader->count)
+            break;
+
+        int err = load_one(loader, index);
+        if (loader->errors)
+            loader->errors[index] = err;
+        if (err != 0) {
+            pthread_mutex_lock(&loader->lock);
+            loader->failed++;
+            pthread_mutex_unlock(&loader->lock);
+        }
+    }
+
+    return NULL;
+}
+
+// reads a single file, waiting until its size fits into in-flight budget
+static int load_one(loader_t* loader, size_t index) {
+    const char* path = loader->paths[index];
+    if (!path)
+        return NULL_PTR_ERR;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return IO_READ_ERR;
+
+    struct stat st;
+    size_t size = (fstat(fd, &st) == 0 && st.st_size > 0) ? (size_t) st.st_size : 0;
+
+    if (loader->max_inflight) {
+        pthread_mutex_lock(&loader->lock);
+        while (loader->inflight > 0 && loader->inflight + size > loader->max_inflight)
+            pthread_cond_wait(&loader->budget_freed, &loader->lock);
+        loader->inflight += size;
+        pthread_mutex_unlock(&loader->lock);
+    }
+
+    int err = my_str_read_fd(&loader->strs[index], fd, 0);
+    close(fd);
+
+    if (loader->max_inflight) {
+        pthread_mutex_lock(&loader->lock);
+        loader->inflight -= size;
+        pthread_cond_broadcast(&loader->budget_freed);
+        pthread_mutex_unlock(&loader->lock);
+    }
+
+    return err;
+}
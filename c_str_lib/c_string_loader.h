@@ -0,0 +1,28 @@
+#pragma once
+#ifndef C_STRING_LOADER_H
+#define C_STRING_LOADER_H
+
+#include "c_string.h"
+
+/*
+ * loads given files into array of my_str-strings concurrently, using pool of worker threads
+ * every file is read with my_str_read_fd, so its buffer is reserved for the whole file at once
+ * strs: array of count strings, each created with my_str_create
+ * paths: array of count paths, strs[i] gets content of paths[i]
+ * threads: number of worker threads; if 0 then number of online CPUs is used
+ * max_inflight: upper bound of bytes that are being read at the same time, 0 means no bound;
+ *      a file that is bigger than the bound is read when nothing else is in flight
+ * errors: array of count result codes (may be NULL), errors[i] is set to
+ *      0 if paths[i] was loaded
+ *      NULL_PTR_ERR if paths[i] is NULL
+ *      IO_READ_ERR if file can not be opened or read
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ * return:
+ *      0  if all files were loaded
+ *      NULL_PTR_ERR if strs or paths is NULL
+ *      IO_READ_ERR if at least one file was not loaded (see errors)
+ */
+int my_str_read_files(my_str_t* strs, const char* const* paths, size_t count,
+                      size_t threads, size_t max_inflight, int* errors);
+
+#endif // C_STRING_LOADER_H
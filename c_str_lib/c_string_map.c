@@ -0,0 +1,387 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_map.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define CTRL_EMPTY ((signed char) -128)
+#define CTRL_DELETED ((signed char) -2)
+// control byte of a full slot, the rest of hash selects the group
+#define HASH_CTRL(h) ((signed char) ((h) & 0x7f))
+#define HASH_GROUP(h) ((h) >> 7)
+
+static unsigned group_match(const signed char* ctrl, signed char byte);
+static unsigned group_match_free(const signed char* ctrl);
+static unsigned lowest_bit(unsigned mask);
+static size_t find_slot(const my_str_map_t* map, my_str_view_t key, uint64_t hash);
+static size_t find_free_slot(const my_str_map_t* map, uint64_t hash);
+static int rehash(my_str_map_t* map, size_t capacity);
+static size_t capacity_for(size_t size);
+
+/*
+ * creates empty map
+ * !important! user should always use my_str_map_create before using ANY other map function
+ * capacity: number of keys that can be inserted without rehashing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if map is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_map_create(my_str_map_t* map, size_t capacity) {
+    if (!map)
+        return NULL_PTR_ERR;
+
+    memset(map, 0, sizeof(*map));
+    int err = my_str_create(&map->keys, 0);
+    if (err != 0) return err;
+
+    err = my_str_map_reserve(map, capacity);
+    if (err != 0) {
+        my_str_map_free(map);
+        return err;
+    }
+
+    return 0;
+}
+
+/*
+ * frees all data of the map
+ * return:
+ *     0 always
+ */
+int my_str_map_free(my_str_map_t* map) {
+    if (!map)
+        return 0;
+
+    free(map->ctrl);
+    free(map->slots);
+    my_str_free(&map->keys);
+    memset(map, 0, sizeof(*map));
+
+    return 0;
+}
+
+/*
+ * returns number of keys in the map
+ * if map == NULL than size = 0
+ */
+size_t my_str_map_size(const my_str_map_t* map) {
+    return (!map) ? 0 : map->size_m;
+}
+
+/*
+ * makes room for given number of keys, so that inserting them does not rehash
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if map is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_map_reserve(my_str_map_t* map, size_t size) {
+    if (!map)
+        return NULL_PTR_ERR;
+
+    if (size == 0 || size <= map->capacity / 8 * 7 - map->deleted)
+        return 0;
+
+    size_t capacity = capacity_for(size);
+    if (!capacity)
+        return MEMORY_ALLOCATION_ERR;
+
+    return rehash(map, capacity);
+}
+
+/*
+ * inserts copy of the key with given value, value of already present key is replaced
+ * return:
+ *      0  if key was inserted
+ *      1  if key was already present
+ *      NULL_PTR_ERR if map is NULL or key has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_map_insert(my_str_map_t* map, my_str_view_t key, void* value) {
+    if (!map || (!key.data && key.size_m))
+        return NULL_PTR_ERR;
+
+    uint64_t hash = my_str_hash_view(key, 0);
+    size_t slot = find_slot(map, key, hash);
+    if (slot != SIZE_MAX) {
+        map->slots[slot].value = value;
+        return 1;
+    }
+
+    // keeps at least 1/8 of slots empty, so that probing stays short
+    if (map->size_m + map->deleted + 1 > map->capacity / 8 * 7) {
+        size_t capacity = capacity_for(map->size_m + 1);
+        if (!capacity)
+            return MEMORY_ALLOCATION_ERR;
+        int err = rehash(map, capacity);
+        if (err != 0) return err;
+    }
+
+    my_str_t* keys = &map->keys;
+    if (key.size_m > keys->capacity_m - keys->size_m) {
+        if (key.size_m > SIZE_MAX / 2 - keys->size_m)
+            return MEMORY_ALLOCATION_ERR;
+        size_t needed = keys->size_m + key.size_m;
+        int err = my_str_reserve(keys, (needed > keys->capacity_m * 2) ? needed : keys->capacity_m * 2);
+        if (err != 0) return err;
+    }
+    if (key.size_m)
+        memcpy(keys->data + keys->size_m, key.data, key.size_m);
+
+    slot = find_free_slot(map, hash);
+    if (map->ctrl[slot] == CTRL_DELETED)
+        map->deleted--;
+    map->ctrl[slot] = HASH_CTRL(hash);
+    map->slots[slot].hash = hash;
+    map->slots[slot].key_offset = keys->size_m;
+    map->slots[slot].key_size = key.size_m;
+    map->slots[slot].value = value;
+
+    keys->size_m += key.size_m;
+    map->size_m++;
+
+    return 0;
+}
+
+/*
+ * looks for the key, nothing is allocated
+ * value: if not NULL and key is found, its value is saved there
+ * return:
+ *      0  if key is found
+ *      NOT_FOUND_CODE if key is not in the map
+ *      NULL_PTR_ERR if map is NULL
+ */
+int my_str_map_find(const my_str_map_t* map, my_str_view_t key, void** value) {
+    if (!map)
+        return NULL_PTR_ERR;
+
+    size_t slot = find_slot(map, key, my_str_hash_view(key, 0));
+    if (slot == SIZE_MAX)
+        return NOT_FOUND_CODE;
+
+    if (value) *value = map->slots[slot].value;
+    return 0;
+}
+
+/*
+ * the same as my_str_map_find, but takes my_str-string as a key
+ * hash remembered by my_str_hash_cached is used instead of hashing the key again
+ * return:
+ *      the same as in my_str_map_find, NULL_PTR_ERR if key is NULL too
+ */
+int my_str_map_find_str(const my_str_map_t* map, const my_str_t* key, void** value) {
+    if (!map || !key)
+        return NULL_PTR_ERR;
+
+    uint64_t hash = key->hash_m ? key->hash_m : my_str_hash(key, 0);
+    size_t slot = find_slot(map, my_str_view(key), hash);
+    if (slot == SIZE_MAX)
+        return NOT_FOUND_CODE;
+
+    if (value) *value = map->slots[slot].value;
+    return 0;
+}
+
+/*
+ * removes the key from the map
+ * return:
+ *      0  if key was removed
+ *      NOT_FOUND_CODE if key is not in the map
+ *      NULL_PTR_ERR if map is NULL
+ */
+int my_str_map_erase(my_str_map_t* map, my_str_view_t key) {
+    if (!map)
+        return NULL_PTR_ERR;
+
+    size_t slot = find_slot(map, key, my_str_hash_view(key, 0));
+    if (slot == SIZE_MAX)
+        return NOT_FOUND_CODE;
+
+    // probing never went past a group with an empty slot, so such slot may become empty again
+    size_t group = slot & ~(size_t) (MY_STR_MAP_GROUP - 1);
+    if (group_match(map->ctrl + group, CTRL_EMPTY)) {
+        map->ctrl[slot] = CTRL_EMPTY;
+    } else {
+        map->ctrl[slot] = CTRL_DELETED;
+        map->deleted++;
+    }
+
+    map->keys_garbage += map->slots[slot].key_size;
+    map->size_m--;
+
+    return 0;
+}
+
+/*
+ * iterates over all keys of the map in unspecified order
+ * iter: should be 0 before the first call, is updated by every call
+ * key, value: if not NULL, the next key and its value are saved there
+ * key view is valid until the next change of the map
+ * return:
+ *      0  if the next key is found
+ *      NOT_FOUND_CODE if there are no more keys
+ *      NULL_PTR_ERR if map or iter is NULL
+ */
+int my_str_map_next(const my_str_map_t* map, size_t* iter, my_str_view_t* key, void** value) {
+    if (!map || !iter)
+        return NULL_PTR_ERR;
+
+    for (; *iter < map->capacity; (*iter)++) {
+        if (map->ctrl[*iter] < 0)
+            continue;
+
+        const my_str_map_slot_t* slot = &map->slots[(*iter)++];
+        if (key) {
+            key->data = map->keys.data + slot->key_offset;
+            key->size_m = slot->key_size;
+        }
+        if (value) *value = slot->value;
+        return 0;
+    }
+
+    return NOT_FOUND_CODE;
+}
+
+// bit i of result is set if ctrl[i] == byte
+static unsigned group_match(const signed char* ctrl, signed char byte) {
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i *) ctrl);
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(byte)));
+#else
+    unsigned mask = 0;
+    for (unsigned i = 0; i < MY_STR_MAP_GROUP; i++)
+        mask |= (unsigned) (ctrl[i] == byte) << i;
+    return mask;
+#endif
+}
+
+// bit i of result is set if slot i is empty or deleted (both have the sign bit)
+static unsigned group_match_free(const signed char* ctrl) {
+#ifdef __SSE2__
+    return (unsigned) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) ctrl));
+#else
+    unsigned mask = 0;
+    for (unsigned i = 0; i < MY_STR_MAP_GROUP; i++)
+        mask |= (unsigned) (ctrl[i] < 0) << i;
+    return mask;
+#endif
+}
+
+static unsigned lowest_bit(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned) __builtin_ctz(mask);
+#else
+    unsigned i = 0;
+    for (; !(mask & 1u); mask >>= 1)
+        i++;
+    return i;
+#endif
+}
+
+// returns slot of the key or SIZE_MAX; groups are probed in triangular order
+static size_t find_slot(const my_str_map_t* map, my_str_view_t key, uint64_t hash) {
+    if (!map->capacity)
+        return SIZE_MAX;
+
+    size_t groups_mask = map->capacity / MY_STR_MAP_GROUP - 1;
+    size_t group = (size_t) HASH_GROUP(hash) & groups_mask;
+    for (size_t step = 1; step <= groups_mask + 1; step++) {
+        const signed char* ctrl = map->ctrl + group * MY_STR_MAP_GROUP;
+        for (unsigned mask = group_match(ctrl, HASH_CTRL(hash)); mask; mask &= mask - 1) {
+            size_t slot = group * MY_STR_MAP_GROUP + lowest_bit(mask);
+            const my_str_map_slot_t* entry = &map->slots[slot];
+            if (entry->hash == hash && entry->key_size == key.size_m &&
+                (key.size_m == 0 || memcmp(map->keys.data + entry->key_offset, key.data, key.size_m) == 0))
+                return slot;
+        }
+        if (group_match(ctrl, CTRL_EMPTY))
+            return SIZE_MAX;
+        group = (group + step) & groups_mask;
+    }
+
+    return SIZE_MAX;
+}
+
+// returns the first empty or deleted slot on the probe sequence of hash
+static size_t find_free_slot(const my_str_map_t* map, uint64_t hash) {
+    size_t groups_mask = map->capacity / MY_STR_MAP_GROUP - 1;
+    size_t group = (size_t) HASH_GROUP(hash) & groups_mask;
+    for (size_t step = 1;; step++) {
+        unsigned mask = group_match_free(map->ctrl + group * MY_STR_MAP_GROUP);
+        if (mask)
+            return group * MY_STR_MAP_GROUP + lowest_bit(mask);
+        group = (group + step) & groups_mask;
+    }
+}
+
+// moves all keys to new tables of given capacity, compacting the arena if it is mostly garbage
+static int rehash(my_str_map_t* map, size_t capacity) {
+    signed char* ctrl = (signed char *) malloc(capacity);
+    my_str_map_slot_t* slots = (my_str_map_slot_t *) malloc(capacity * sizeof(my_str_map_slot_t));
+    if (!ctrl || !slots) {
+        free(ctrl);
+        free(slots);
+        return MEMORY_ALLOCATION_ERR;
+    }
+    memset(ctrl, CTRL_EMPTY, capacity);
+
+    my_str_t keys = {0};
+    int compact = map->keys_garbage > map->keys.size_m / 2;
+    if (compact) {
+        int err = my_str_create(&keys, map->keys.size_m - map->keys_garbage);
+        if (err != 0) {
+            free(ctrl);
+            free(slots);
+            return err;
+        }
+    }
+
+    my_str_map_t resized = *map;
+    resized.ctrl = ctrl;
+    resized.slots = slots;
+    resized.capacity = capacity;
+    resized.deleted = 0;
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (map->ctrl[i] < 0)
+            continue;
+
+        my_str_map_slot_t entry = map->slots[i];
+        if (compact) {
+            memcpy(keys.data + keys.size_m, map->keys.data + entry.key_offset, entry.key_size);
+            entry.key_offset = keys.size_m;
+            keys.size_m += entry.key_size;
+        }
+        size_t slot = find_free_slot(&resized, entry.hash);
+        ctrl[slot] = HASH_CTRL(entry.hash);
+        slots[slot] = entry;
+    }
+
+    free(map->ctrl);
+    free(map->slots);
+    map->ctrl = ctrl;
+    map->slots = slots;
+    map->capacity = capacity;
+    map->deleted = 0;
+    if (compact) {
+        my_str_free(&map->keys);
+        map->keys = keys;
+        map->keys_garbage = 0;
+    }
+
+    return 0;
+}
+
+// smallest power of two capacity that keeps size keys below 7/8 load, 0 on overflow
+static size_t capacity_for(size_t size) {
+    if (size > SIZE_MAX / 16)
+        return 0;
+
+    size_t capacity = MY_STR_MAP_GROUP;
+    while (capacity / 8 * 7 < size)
+        capacity *= 2;
+
+    return capacity;
+}
@@ -0,0 +1,114 @@
+#pragma once
+#ifndef C_STRING_MAP_H
+#define C_STRING_MAP_H
+
+#include "c_string.h"
+
+#define MY_STR_MAP_GROUP 16 // number of control bytes probed at once
+
+// one entry of the map, key bytes are kept in the keys arena of the map
+typedef struct {
+    uint64_t hash;      // my_str_hash of the key with seed 0
+    size_t key_offset;  // position of the key in the arena
+    size_t key_size;
+    void *value;
+} my_str_map_slot_t;
+
+/*
+ * open addressing hash map from strings to pointers (SwissTable layout)
+ * every slot has a control byte: empty, deleted or 7 low bits of the key hash,
+ * lookups compare whole group of control bytes at once and look at keys only on match
+ */
+typedef struct {
+    signed char *ctrl;         // capacity control bytes
+    my_str_map_slot_t *slots;
+    size_t capacity;           // number of slots, 0 or power of two not less than MY_STR_MAP_GROUP
+    size_t size_m;             // number of keys
+    size_t deleted;            // number of slots marked as deleted
+    my_str_t keys;             // arena with bytes of all keys
+    size_t keys_garbage;       // bytes of erased keys in the arena
+} my_str_map_t;
+
+/*
+ * creates empty map
+ * !important! user should always use my_str_map_create before using ANY other map function
+ * capacity: number of keys that can be inserted without rehashing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if map is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_map_create(my_str_map_t* map, size_t capacity);
+
+/*
+ * frees all data of the map
+ * return:
+ *     0 always
+ */
+int my_str_map_free(my_str_map_t* map);
+
+/*
+ * returns number of keys in the map
+ * if map == NULL than size = 0
+ */
+size_t my_str_map_size(const my_str_map_t* map);
+
+/*
+ * makes room for given number of keys, so that inserting them does not rehash
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if map is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_map_reserve(my_str_map_t* map, size_t size);
+
+/*
+ * inserts copy of the key with given value, value of already present key is replaced
+ * return:
+ *      0  if key was inserted
+ *      1  if key was already present
+ *      NULL_PTR_ERR if map is NULL or key has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_map_insert(my_str_map_t* map, my_str_view_t key, void* value);
+
+/*
+ * looks for the key, nothing is allocated
+ * value: if not NULL and key is found, its value is saved there
+ * return:
+ *      0  if key is found
+ *      NOT_FOUND_CODE if key is not in the map
+ *      NULL_PTR_ERR if map is NULL
+ */
+int my_str_map_find(const my_str_map_t* map, my_str_view_t key, void** value);
+
+/*
+ * the same as my_str_map_find, but takes my_str-string as a key
+ * hash remembered by my_str_hash_cached is used instead of hashing the key again
+ * return:
+ *      the same as in my_str_map_find, NULL_PTR_ERR if key is NULL too
+ */
+int my_str_map_find_str(const my_str_map_t* map, const my_str_t* key, void** value);
+
+/*
+ * removes the key from the map
+ * return:
+ *      0  if key was removed
+ *      NOT_FOUND_CODE if key is not in the map
+ *      NULL_PTR_ERR if map is NULL
+ */
+int my_str_map_erase(my_str_map_t* map, my_str_view_t key);
+
+/*
+ * iterates over all keys of the map in unspecified order
+ * iter: should be 0 before the first call, is updated by every call
+ * key, value: if not NULL, the next key and its value are saved there
+ * key view is valid until the next change of the map
+ * return:
+ *      0  if the next key is found
+ *      NOT_FOUND_CODE if there are no more keys
+ *      NULL_PTR_ERR if map or iter is NULL
+ */
+int my_str_map_next(const my_str_map_t* map, size_t* iter, my_str_view_t* key, void** value);
+
+#endif // C_STRING_MAP_H
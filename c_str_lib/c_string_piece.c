@@ -0,0 +1,500 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_piece.h"
+
+static size_t total(const my_str_piece_t* node);
+static void update(my_str_piece_t* node);
+static int fill_pool(my_str_piece_table_t* table, size_t count);
+static my_str_piece_t* take_node(my_str_piece_table_t* table);
+static void release(my_str_piece_table_t* table, my_str_piece_t* node);
+static my_str_piece_t* unique(my_str_piece_table_t* table, my_str_piece_t* node);
+static size_t split_cost(const my_str_piece_t* node, size_t pos);
+static void split(my_str_piece_table_t* table, my_str_piece_t* node, size_t pos,
+                  my_str_piece_t** left, my_str_piece_t** right);
+static my_str_piece_t* merge(my_str_piece_t* left, my_str_piece_t* right);
+static int extend_last_insert(my_str_piece_table_t* table, size_t pos, size_t size);
+static int visit(const my_str_piece_table_t* table, const my_str_piece_t* node, size_t start,
+                 size_t from, size_t to, my_str_chunk_callback callback, void* arg);
+static int write_chunk(const char* chunk, size_t size, void* arg);
+static int copy_chunk(const char* chunk, size_t size, void* arg);
+
+/*
+ * creates table with content of original
+ * !important! user should always use my_str_piece_create before using ANY other piece table function
+ * original: buffer (for example from my_str_read_file or mmap), it is not copied,
+ * so it must not change while the table is used
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table is NULL or original has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_piece_create(my_str_piece_table_t* table, my_str_view_t original) {
+    if (!table || (!original.data && original.size_m))
+        return NULL_PTR_ERR;
+
+    int err = my_str_create(&table->added, 0);
+    if (err != 0) return err;
+
+    table->original = original;
+    table->root = table->pool = NULL;
+    table->pool_size = 0;
+    // any non zero state works for xorshift
+    table->seed = ((uint64_t) (uintptr_t) table) ^ 0x9E3779B97F4A7C15ull;
+
+    if (original.size_m) {
+        if (fill_pool(table, 1) != 0) {
+            my_str_free(&table->added);
+            return MEMORY_ALLOCATION_ERR;
+        }
+        table->root = take_node(table);
+        table->root->size_m = table->root->total = original.size_m;
+    }
+
+    return 0;
+}
+
+/*
+ * frees all data of the table, all its snapshots must be released before
+ * return:
+ *     0 always
+ */
+int my_str_piece_free(my_str_piece_table_t* table) {
+    if (!table)
+        return 0;
+
+    release(table, table->root);
+    table->root = NULL;
+    while (table->pool) {
+        my_str_piece_t* next = table->pool->left;
+        free(table->pool);
+        table->pool = next;
+    }
+    table->pool_size = 0;
+    my_str_free(&table->added);
+
+    return 0;
+}
+
+/*
+ * returns size of the text
+ * if table == NULL than size = 0
+ */
+size_t my_str_piece_size(const my_str_piece_table_t* table) {
+    if (!table)
+        return 0;
+    return total(table->root);
+}
+
+/*
+ * inserts data before given position, pos == size appends it
+ * appending right after the previous insert extends its piece
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table is NULL or data has NULL data and non zero size
+ *      RANGE_ERR if pos is bigger than size of the text
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation, text is not changed
+ */
+int my_str_piece_insert(my_str_piece_table_t* table, size_t pos, my_str_view_t data) {
+    if (!table || (!data.data && data.size_m))
+        return NULL_PTR_ERR;
+    if (pos > total(table->root))
+        return RANGE_ERR;
+    if (!data.size_m)
+        return 0;
+
+    // bytes that are not referenced by pieces yet do not change the text
+    my_str_t* added = &table->added;
+    if (data.size_m > added->capacity_m - added->size_m) {
+        if (data.size_m > SIZE_MAX / 2 - added->size_m)
+            return MEMORY_ALLOCATION_ERR;
+        size_t needed = added->size_m + data.size_m;
+        int err = my_str_reserve(added, (needed > added->capacity_m * 2) ? needed : added->capacity_m * 2);
+        if (err != 0) return err;
+    }
+    memcpy(added->data + added->size_m, data.data, data.size_m);
+
+    if (extend_last_insert(table, pos, data.size_m)) {
+        added->size_m += data.size_m;
+        return 0;
+    }
+
+    if (fill_pool(table, split_cost(table->root, pos) + 1) != 0)
+        return MEMORY_ALLOCATION_ERR;
+
+    my_str_piece_t* piece = take_node(table);
+    piece->added = 1;
+    piece->offset = added->size_m;
+    piece->size_m = piece->total = data.size_m;
+    added->size_m += data.size_m;
+
+    my_str_piece_t *left = NULL, *right = NULL;
+    split(table, table->root, pos, &left, &right);
+    table->root = merge(merge(left, piece), right);
+
+    return 0;
+}
+
+/*
+ * erases size bytes beginning from pos, or less if the text ends earlier
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table is NULL
+ *      RANGE_ERR if pos is bigger than size of the text
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation, text is not changed
+ */
+int my_str_piece_erase(my_str_piece_table_t* table, size_t pos, size_t size) {
+    if (!table)
+        return NULL_PTR_ERR;
+    size_t text_size = total(table->root);
+    if (pos > text_size)
+        return RANGE_ERR;
+    if (size > text_size - pos)
+        size = text_size - pos;
+    if (!size)
+        return 0;
+
+    if (fill_pool(table, split_cost(table->root, pos)) != 0)
+        return MEMORY_ALLOCATION_ERR;
+
+    my_str_piece_t *left = NULL, *rest = NULL, *middle = NULL, *right = NULL;
+    split(table, table->root, pos, &left, &rest);
+    if (fill_pool(table, split_cost(rest, size)) != 0) {
+        // merging never allocates, the text stays the same with one piece cut in two
+        table->root = merge(left, rest);
+        return MEMORY_ALLOCATION_ERR;
+    }
+    split(table, rest, size, &middle, &right);
+    release(table, middle);
+    table->root = merge(left, right);
+
+    return 0;
+}
+
+/*
+ * saves current state of the table in O(1), following edits do not change it
+ * snapshot must be released with my_str_piece_release
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or snapshot is NULL
+ */
+int my_str_piece_snapshot(my_str_piece_table_t* table, my_str_piece_snapshot_t* snapshot) {
+    if (!table || !snapshot)
+        return NULL_PTR_ERR;
+
+    snapshot->root = table->root;
+    if (snapshot->root)
+        snapshot->root->refs++;
+
+    return 0;
+}
+
+/*
+ * returns the table to the state saved in snapshot, snapshot stays valid
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or snapshot is NULL
+ */
+int my_str_piece_restore(my_str_piece_table_t* table, const my_str_piece_snapshot_t* snapshot) {
+    if (!table || !snapshot)
+        return NULL_PTR_ERR;
+
+    if (snapshot->root)
+        snapshot->root->refs++;
+    release(table, table->root);
+    table->root = snapshot->root;
+
+    return 0;
+}
+
+/*
+ * releases pieces of the snapshot that are not used by the table or other snapshots
+ * return:
+ *     0 always
+ */
+int my_str_piece_release(my_str_piece_table_t* table, my_str_piece_snapshot_t* snapshot) {
+    if (!table || !snapshot)
+        return 0;
+
+    release(table, snapshot->root);
+    snapshot->root = NULL;
+
+    return 0;
+}
+
+/*
+ * calls callback for every chunk of bytes [pos, pos + size) in order, or less if the text
+ * ends earlier; chunks point into the original and append buffers, nothing is copied
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or callback is NULL
+ *      RANGE_ERR if pos is bigger than size of the text
+ *      else - non zero value returned by callback, next chunks are not visited
+ */
+int my_str_piece_for_each(const my_str_piece_table_t* table, size_t pos, size_t size,
+                          my_str_chunk_callback callback, void* arg) {
+    if (!table || !callback)
+        return NULL_PTR_ERR;
+    size_t text_size = total(table->root);
+    if (pos > text_size)
+        return RANGE_ERR;
+    if (size > text_size - pos)
+        size = text_size - pos;
+
+    return visit(table, table->root, 0, pos, pos + size, callback, arg);
+}
+
+/*
+ * writes the text to file piece by piece, without building it in memory
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or file is NULL
+ *      IO_WRITE_ERR if there was an error during writing
+ */
+int my_str_piece_write_file(const my_str_piece_table_t* table, FILE* file) {
+    if (!table || !file)
+        return NULL_PTR_ERR;
+
+    return visit(table, table->root, 0, 0, total(table->root), write_chunk, file);
+}
+
+/*
+ * copies the text into my_str-string, its buffer is resized once if needed
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_piece_to_str(const my_str_piece_table_t* table, my_str_t* str) {
+    if (!table || !str)
+        return NULL_PTR_ERR;
+
+    // old content is not needed, so it is not copied by reserve
+    str->size_m = 0;
+    str->hash_m = 0;
+    int err = my_str_reserve(str, total(table->root));
+    if (err != 0) return err;
+
+    visit(table, table->root, 0, 0, total(table->root), copy_chunk, str);
+    return 0;
+}
+
+static size_t total(const my_str_piece_t* node) {
+    return node ? node->total : 0;
+}
+
+static void update(my_str_piece_t* node) {
+    node->total = total(node->left) + node->size_m + total(node->right);
+}
+
+// makes sure that the next count nodes can be taken without allocation failures
+static int fill_pool(my_str_piece_table_t* table, size_t count) {
+    while (table->pool_size < count) {
+        my_str_piece_t* node = (my_str_piece_t *) malloc(sizeof(my_str_piece_t));
+        if (!node)
+            return MEMORY_ALLOCATION_ERR;
+        node->left = table->pool;
+        table->pool = node;
+        table->pool_size++;
+    }
+    return 0;
+}
+
+// empty node of the original with the next priority of xorshift generator, pool must not be empty
+static my_str_piece_t* take_node(my_str_piece_table_t* table) {
+    my_str_piece_t* node = table->pool;
+    table->pool = node->left;
+    table->pool_size--;
+
+    table->seed ^= table->seed << 13;
+    table->seed ^= table->seed >> 7;
+    table->seed ^= table->seed << 17;
+    node->priority = table->seed;
+    node->left = node->right = NULL;
+    node->refs = 1;
+    node->added = 0;
+    node->offset = node->size_m = node->total = 0;
+    return node;
+}
+
+// drops one reference, node that is not referenced anymore releases its children
+static void release(my_str_piece_table_t* table, my_str_piece_t* node) {
+    while (node && --node->refs == 0) {
+        release(table, node->left);
+        my_str_piece_t* right = node->right;
+        if (table->pool_size < MY_STR_PIECE_POOL) {
+            node->left = table->pool;
+            table->pool = node;
+            table->pool_size++;
+        } else {
+            free(node);
+        }
+        node = right;
+    }
+}
+
+// node that may be changed: the same one if nobody else references it, else its copy
+static my_str_piece_t* unique(my_str_piece_table_t* table, my_str_piece_t* node) {
+    if (node->refs == 1)
+        return node;
+
+    my_str_piece_t* copy = take_node(table);
+    *copy = *node;
+    copy->refs = 1;
+    if (copy->left)
+        copy->left->refs++;
+    if (copy->right)
+        copy->right->refs++;
+    node->refs--;
+    return copy;
+}
+
+// number of nodes that split at pos may take from the pool: copies of the path and the cut piece
+static size_t split_cost(const my_str_piece_t* node, size_t pos) {
+    size_t cost = 1;
+    while (node) {
+        cost++;
+        size_t left_size = total(node->left);
+        if (pos <= left_size) {
+            node = node->left;
+        } else if (pos >= left_size + node->size_m) {
+            pos -= left_size + node->size_m;
+            node = node->right;
+        } else {
+            break;
+        }
+    }
+    return cost;
+}
+
+// divides tree into the first pos bytes and the rest, takes the reference of node;
+// all nodes on the edges of both parts are unique, so merging them never allocates
+static void split(my_str_piece_table_t* table, my_str_piece_t* node, size_t pos,
+                  my_str_piece_t** left, my_str_piece_t** right) {
+    if (!node) {
+        *left = *right = NULL;
+        return;
+    }
+
+    node = unique(table, node);
+    size_t left_size = total(node->left);
+    if (pos <= left_size) {
+        split(table, node->left, pos, left, &node->left);
+        update(node);
+        *right = node;
+    } else if (pos >= left_size + node->size_m) {
+        split(table, node->right, pos - left_size - node->size_m, &node->right, right);
+        update(node);
+        *left = node;
+    } else {
+        // tail gets the priority of the cut piece, so it becomes root of the right part at once
+        size_t cut = pos - left_size;
+        my_str_piece_t* tail = take_node(table);
+        tail->priority = node->priority;
+        tail->added = node->added;
+        tail->offset = node->offset + cut;
+        tail->size_m = node->size_m - cut;
+        tail->right = node->right;
+        update(tail);
+
+        node->right = NULL;
+        node->size_m = cut;
+        update(node);
+        *left = node;
+        *right = tail;
+    }
+}
+
+// tree with all pieces of left followed by all pieces of right, takes both references;
+// edges of trees made by split are unique, so nodes are changed in place
+static my_str_piece_t* merge(my_str_piece_t* left, my_str_piece_t* right) {
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+
+    if (left->priority >= right->priority) {
+        left->right = merge(left->right, right);
+        update(left);
+        return left;
+    }
+    right->left = merge(left, right->left);
+    update(right);
+    return right;
+}
+
+// if the piece that ends at pos ends at the end of the append buffer, and no snapshot shares
+// the path to it, size bytes just appended to the buffer are added to this piece
+static int extend_last_insert(my_str_piece_table_t* table, size_t pos, size_t size) {
+    my_str_piece_t* node = table->root;
+    size_t offset = pos;
+    while (node) {
+        if (node->refs != 1)
+            return 0;
+        size_t left_size = total(node->left);
+        if (offset < left_size || (offset == left_size && node->left)) {
+            node = node->left;
+        } else if (offset <= left_size + node->size_m) {
+            offset -= left_size;
+            break;
+        } else {
+            offset -= left_size + node->size_m;
+            node = node->right;
+        }
+    }
+    if (!node || !node->added || offset != node->size_m || node->offset + node->size_m != table->added.size_m)
+        return 0;
+
+    // the same path once more, now changing sizes
+    my_str_piece_t* target = node;
+    for (node = table->root; node != target;) {
+        size_t left_size = total(node->left);
+        node->total += size;
+        if (pos < left_size || (pos == left_size && node->left)) {
+            node = node->left;
+        } else {
+            pos -= left_size + node->size_m;
+            node = node->right;
+        }
+    }
+    target->size_m += size;
+    target->total += size;
+    return 1;
+}
+
+// calls callback for parts of pieces in [from, to), start - position of the subtree in the text
+static int visit(const my_str_piece_table_t* table, const my_str_piece_t* node, size_t start,
+                 size_t from, size_t to, my_str_chunk_callback callback, void* arg) {
+    while (node && start < to && start + node->total > from) {
+        int res = visit(table, node->left, start, from, to, callback, arg);
+        if (res)
+            return res;
+
+        size_t piece_start = start + total(node->left);
+        size_t piece_end = piece_start + node->size_m;
+        size_t low = from > piece_start ? from : piece_start;
+        size_t high = to < piece_end ? to : piece_end;
+        if (low < high) {
+            const char* data = node->added ? table->added.data : table->original.data;
+            res = callback(data + node->offset + (low - piece_start), high - low, arg);
+            if (res)
+                return res;
+        }
+
+        start = piece_end;
+        node = node->right;
+    }
+    return 0;
+}
+
+static int write_chunk(const char* chunk, size_t size, void* arg) {
+    if (fwrite(chunk, 1, size, (FILE *) arg) != size)
+        return IO_WRITE_ERR;
+    return 0;
+}
+
+static int copy_chunk(const char* chunk, size_t size, void* arg) {
+    my_str_t* str = arg;
+    memcpy(str->data + str->size_m, chunk, size);
+    str->size_m += size;
+    return 0;
+}
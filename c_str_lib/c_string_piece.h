@@ -0,0 +1,141 @@
+#pragma once
+#ifndef C_STRING_PIECE_H
+#define C_STRING_PIECE_H
+
+#include "c_string.h"
+
+#define MY_STR_PIECE_POOL 64 // freed nodes kept for reuse by the next edits
+
+// piece of the text: bytes [offset, offset + size_m) of the original or of the append buffer;
+// pieces are nodes of a treap shared between the table and its snapshots
+typedef struct my_str_piece {
+    struct my_str_piece *left;
+    struct my_str_piece *right;
+    size_t refs;        // number of parents, tables and snapshots that reference the node
+    uint64_t priority;
+    int added;          // 0 - piece of the original, 1 - piece of the append buffer
+    size_t offset;
+    size_t size_m;
+    size_t total;       // bytes in this subtree
+} my_str_piece_t;
+
+/*
+ * text as a sequence of pieces over an immutable original buffer and an append-only buffer
+ * of inserted bytes, so edits never copy the text; pieces are kept in a balanced tree, edits
+ * take O(log pieces) and copy only the changed path, so snapshots share everything else
+ */
+typedef struct {
+    my_str_view_t original;   // is not copied, must stay valid while the table is used
+    my_str_t added;           // all inserted bytes, only appended to
+    my_str_piece_t *root;
+    my_str_piece_t *pool;     // free nodes linked through left
+    size_t pool_size;
+    uint64_t seed;            // state of generator of priorities
+} my_str_piece_table_t;
+
+// saved state of the table, restoring it is undo
+typedef struct {
+    my_str_piece_t *root;
+} my_str_piece_snapshot_t;
+
+/*
+ * creates table with content of original
+ * !important! user should always use my_str_piece_create before using ANY other piece table function
+ * original: buffer (for example from my_str_read_file or mmap), it is not copied,
+ * so it must not change while the table is used
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table is NULL or original has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_piece_create(my_str_piece_table_t* table, my_str_view_t original);
+
+/*
+ * frees all data of the table, all its snapshots must be released before
+ * return:
+ *     0 always
+ */
+int my_str_piece_free(my_str_piece_table_t* table);
+
+/*
+ * returns size of the text
+ * if table == NULL than size = 0
+ */
+size_t my_str_piece_size(const my_str_piece_table_t* table);
+
+/*
+ * inserts data before given position, pos == size appends it
+ * appending right after the previous insert extends its piece
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table is NULL or data has NULL data and non zero size
+ *      RANGE_ERR if pos is bigger than size of the text
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation, text is not changed
+ */
+int my_str_piece_insert(my_str_piece_table_t* table, size_t pos, my_str_view_t data);
+
+/*
+ * erases size bytes beginning from pos, or less if the text ends earlier
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table is NULL
+ *      RANGE_ERR if pos is bigger than size of the text
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation, text is not changed
+ */
+int my_str_piece_erase(my_str_piece_table_t* table, size_t pos, size_t size);
+
+/*
+ * saves current state of the table in O(1), following edits do not change it
+ * snapshot must be released with my_str_piece_release
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or snapshot is NULL
+ */
+int my_str_piece_snapshot(my_str_piece_table_t* table, my_str_piece_snapshot_t* snapshot);
+
+/*
+ * returns the table to the state saved in snapshot, snapshot stays valid
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or snapshot is NULL
+ */
+int my_str_piece_restore(my_str_piece_table_t* table, const my_str_piece_snapshot_t* snapshot);
+
+/*
+ * releases pieces of the snapshot that are not used by the table or other snapshots
+ * return:
+ *     0 always
+ */
+int my_str_piece_release(my_str_piece_table_t* table, my_str_piece_snapshot_t* snapshot);
+
+/*
+ * calls callback for every chunk of bytes [pos, pos + size) in order, or less if the text
+ * ends earlier; chunks point into the original and append buffers, nothing is copied
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or callback is NULL
+ *      RANGE_ERR if pos is bigger than size of the text
+ *      else - non zero value returned by callback, next chunks are not visited
+ */
+int my_str_piece_for_each(const my_str_piece_table_t* table, size_t pos, size_t size,
+                          my_str_chunk_callback callback, void* arg);
+
+/*
+ * writes the text to file piece by piece, without building it in memory
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or file is NULL
+ *      IO_WRITE_ERR if there was an error during writing
+ */
+int my_str_piece_write_file(const my_str_piece_table_t* table, FILE* file);
+
+/*
+ * copies the text into my_str-string, its buffer is resized once if needed
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if table or str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_piece_to_str(const my_str_piece_table_t* table, my_str_t* str);
+
+#endif // C_STRING_PIECE_H
@@ -0,0 +1,319 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_rolling.h"
+
+#define ROLLING_BASE 0x9e3779b97f4a7c15ull // odd, so multiplication by it is reversible
+#define ROLLING_SEED 0x243f6a8885a308d3ull
+
+static uint64_t splitmix64(uint64_t* state);
+static size_t set_slot(const my_str_rolling_t* roll, uint64_t hash);
+static int set_grow(my_str_rolling_t* roll);
+static int set_find(const my_str_rolling_t* roll, const char* window, uint64_t hash, size_t* id);
+static int is_boundary(const my_str_rolling_t* roll, uint64_t hash, size_t chunk_size);
+
+/*
+ * prepares rolling hash of windows of given size, chunking is set to default sizes
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if roll is NULL
+ *      RANGE_ERR if window is 0
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_rolling_create(my_str_rolling_t* roll, size_t window) {
+    if (!roll)
+        return NULL_PTR_ERR;
+
+    if (window == 0)
+        return RANGE_ERR;
+
+    memset(roll, 0, sizeof(my_str_rolling_t));
+    roll->window = window;
+
+    // the same table for every scanner, so hashes can be compared between them
+    uint64_t state = ROLLING_SEED;
+    for (size_t c = 0; c < 256; c++)
+        roll->table[c] = splitmix64(&state);
+
+    roll->power = 1;
+    for (size_t i = 0; i < window; i++)
+        roll->power *= ROLLING_BASE;
+
+    int err = my_str_create(&roll->patterns, 0);
+    if (err != 0) return err;
+
+    return my_str_rolling_set_chunking(roll, MY_STR_ROLLING_MIN_CHUNK, MY_STR_ROLLING_AVG_CHUNK,
+                                       MY_STR_ROLLING_MAX_CHUNK);
+}
+
+/*
+ * frees all data of rolling hash and its patterns
+ * return:
+ *     0 always
+ */
+int my_str_rolling_free(my_str_rolling_t* roll) {
+    if (!roll)
+        return 0;
+
+    my_str_free(&roll->patterns);
+    free(roll->set_hashes);
+    free(roll->set_ids);
+    roll->set_hashes = NULL;
+    roll->set_ids = NULL;
+    roll->set_bits = 0;
+    roll->patterns_count = 0;
+
+    return 0;
+}
+
+/*
+ * returns hash of data, for data of window size it is equal to the hash of such window in text
+ * if roll == NULL than hash = 0
+ */
+uint64_t my_str_rolling_hash(const my_str_rolling_t* roll, my_str_view_t data) {
+    if (!roll || (!data.data && data.size_m))
+        return 0;
+
+    uint64_t hash = 0;
+    for (size_t i = 0; i < data.size_m; i++)
+        hash = hash * ROLLING_BASE + roll->table[(unsigned char) data.data[i]];
+
+    return hash;
+}
+
+/*
+ * computes hashes of all windows of text, hashes[i] is hash of text[i..i + window)
+ * hashes: array of at least text.size_m - window + 1 elements, nothing is written to it
+ *      if text is shorter than window
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if roll or hashes is NULL
+ */
+int my_str_rolling_hashes(const my_str_rolling_t* roll, my_str_view_t text, uint64_t* hashes) {
+    if (!roll || !hashes || (!text.data && text.size_m))
+        return NULL_PTR_ERR;
+
+    size_t window = roll->window;
+    if (text.size_m < window)
+        return 0;
+
+    const unsigned char* data = (const unsigned char *) text.data;
+    uint64_t hash = 0;
+    for (size_t i = 0; i < window; i++)
+        hash = hash * ROLLING_BASE + roll->table[data[i]];
+    hashes[0] = hash;
+    for (size_t i = window; i < text.size_m; i++) {
+        hash = hash * ROLLING_BASE + roll->table[data[i]] - roll->power * roll->table[data[i - window]];
+        hashes[i - window + 1] = hash;
+    }
+
+    return 0;
+}
+
+/*
+ * adds pattern of window size to the set searched by my_str_rolling_scan
+ * id: if not NULL, id of pattern is saved there, ids go from 0 in order of adding
+ * return:
+ *      0  if pattern was added
+ *      1  if the same pattern was already added, its id is returned
+ *      NULL_PTR_ERR if roll is NULL or pattern has NULL data
+ *      RANGE_ERR if size of pattern is not equal to window
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_rolling_add_pattern(my_str_rolling_t* roll, my_str_view_t pattern, size_t* id) {
+    if (!roll || !pattern.data)
+        return NULL_PTR_ERR;
+
+    if (pattern.size_m != roll->window)
+        return RANGE_ERR;
+
+    uint64_t hash = my_str_rolling_hash(roll, pattern);
+    size_t existing;
+    if (set_find(roll, pattern.data, hash, &existing)) {
+        if (id) *id = existing;
+        return 1;
+    }
+
+    // keeps set at most half full
+    if ((roll->patterns_count + 1) * 2 > ((size_t) 1 << roll->set_bits)) {
+        int err = set_grow(roll);
+        if (err != 0) return err;
+    }
+
+    my_str_t* patterns = &roll->patterns;
+    if (pattern.size_m > patterns->capacity_m - patterns->size_m) {
+        if (pattern.size_m > SIZE_MAX / 2 - patterns->size_m)
+            return MEMORY_ALLOCATION_ERR;
+        size_t needed = patterns->size_m + pattern.size_m;
+        int err = my_str_reserve(patterns, (needed > patterns->capacity_m * 2) ? needed : patterns->capacity_m * 2);
+        if (err != 0) return err;
+    }
+    memcpy(patterns->data + patterns->size_m, pattern.data, pattern.size_m);
+    patterns->size_m += pattern.size_m;
+
+    size_t mask = ((size_t) 1 << roll->set_bits) - 1;
+    size_t slot = set_slot(roll, hash);
+    while (roll->set_ids[slot])
+        slot = (slot + 1) & mask;
+    roll->set_hashes[slot] = hash;
+    roll->set_ids[slot] = roll->patterns_count + 1;
+
+    if (id) *id = roll->patterns_count;
+    roll->patterns_count++;
+
+    return 0;
+}
+
+/*
+ * sets sizes of chunks for content defined chunking
+ * avg_size is rounded down to power of two, it is expected distance between boundaries
+ * that are found after min_size
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if roll is NULL
+ *      RANGE_ERR if min_size > max_size, max_size is 0 or avg_size is 0
+ */
+int my_str_rolling_set_chunking(my_str_rolling_t* roll, size_t min_size, size_t avg_size, size_t max_size) {
+    if (!roll)
+        return NULL_PTR_ERR;
+
+    if (min_size > max_size || max_size == 0 || avg_size == 0)
+        return RANGE_ERR;
+
+    size_t bits = 0;
+    while (bits < 63 && ((size_t) 2 << bits) <= avg_size)
+        bits++;
+
+    roll->min_chunk = min_size;
+    roll->max_chunk = max_size;
+    roll->boundary_mask = bits ? ~(uint64_t) 0 << (64 - bits) : 0;
+
+    return 0;
+}
+
+/*
+ * rolls hash over text once, reports every window equal to one of patterns (hash match is
+ * verified by comparing bytes) and ends of content defined chunks; the last chunk ends at
+ * the end of text; boundary depends only on the window before it and on the previous
+ * boundary, so changes of text move only boundaries near them
+ * on_match, on_boundary: any of them may be NULL, positions are offsets in text
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if roll is NULL or text has NULL data and non zero size
+ *      else - non zero value returned by callback, rest of text is not scanned
+ */
+int my_str_rolling_scan(const my_str_rolling_t* roll, my_str_view_t text,
+                        my_str_rolling_match_callback on_match, my_str_match_callback on_boundary, void* arg) {
+    if (!roll || (!text.data && text.size_m))
+        return NULL_PTR_ERR;
+
+    const unsigned char* data = (const unsigned char *) text.data;
+    size_t window = roll->window, size = text.size_m;
+    int matching = on_match && roll->patterns_count;
+    size_t chunk_start = 0;
+    int err = 0;
+
+    // before the first full window chunks can only be cut by their maximal size
+    size_t first_end = (size < window) ? size : window;
+    for (size_t end = 1; end < first_end && on_boundary; end++) {
+        if (end - chunk_start >= roll->max_chunk) {
+            if ((err = on_boundary(end, arg)) != 0) return err;
+            chunk_start = end;
+        }
+    }
+
+    uint64_t hash = 0;
+    for (size_t i = 0; i < first_end; i++)
+        hash = hash * ROLLING_BASE + roll->table[data[i]];
+
+    // window is text[end - window, end)
+    for (size_t end = window; end <= size; end++) {
+        if (end > window)
+            hash = hash * ROLLING_BASE + roll->table[data[end - 1]] - roll->power * roll->table[data[end - 1 - window]];
+
+        size_t id;
+        if (matching && set_find(roll, text.data + end - window, hash, &id)) {
+            if ((err = on_match(end - window, id, arg)) != 0) return err;
+        }
+
+        if (on_boundary && is_boundary(roll, hash, end - chunk_start) && end < size) {
+            if ((err = on_boundary(end, arg)) != 0) return err;
+            chunk_start = end;
+        }
+    }
+
+    if (on_boundary && size > chunk_start)
+        err = on_boundary(size, arg);
+
+    return err;
+}
+
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// high bits of polynomial hash depend on all bytes of window, low bits do not
+static size_t set_slot(const my_str_rolling_t* roll, uint64_t hash) {
+    return (size_t) (hash >> (64 - roll->set_bits));
+}
+
+// doubles the set and puts all patterns into it again
+static int set_grow(my_str_rolling_t* roll) {
+    size_t bits = roll->set_bits ? roll->set_bits + 1 : 4;
+    size_t capacity = (size_t) 1 << bits;
+    uint64_t* hashes = (uint64_t *) malloc(capacity * sizeof(uint64_t));
+    size_t* ids = (size_t *) calloc(capacity, sizeof(size_t));
+    if (!hashes || !ids) {
+        free(hashes);
+        free(ids);
+        return MEMORY_ALLOCATION_ERR;
+    }
+
+    size_t old_capacity = roll->set_bits ? (size_t) 1 << roll->set_bits : 0;
+    uint64_t* old_hashes = roll->set_hashes;
+    size_t* old_ids = roll->set_ids;
+    roll->set_hashes = hashes;
+    roll->set_ids = ids;
+    roll->set_bits = bits;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (!old_ids[i])
+            continue;
+        size_t slot = set_slot(roll, old_hashes[i]);
+        while (ids[slot])
+            slot = (slot + 1) & (capacity - 1);
+        hashes[slot] = old_hashes[i];
+        ids[slot] = old_ids[i];
+    }
+
+    free(old_hashes);
+    free(old_ids);
+    return 0;
+}
+
+// looks for pattern equal to the window, equal hashes are verified by comparing bytes
+static int set_find(const my_str_rolling_t* roll, const char* window, uint64_t hash, size_t* id) {
+    if (!roll->set_bits)
+        return 0;
+
+    size_t mask = ((size_t) 1 << roll->set_bits) - 1;
+    for (size_t slot = set_slot(roll, hash); roll->set_ids[slot]; slot = (slot + 1) & mask) {
+        if (roll->set_hashes[slot] != hash)
+            continue;
+        size_t candidate = roll->set_ids[slot] - 1;
+        if (memcmp(roll->patterns.data + candidate * roll->window, window, roll->window) == 0) {
+            *id = candidate;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int is_boundary(const my_str_rolling_t* roll, uint64_t hash, size_t chunk_size) {
+    if (chunk_size >= roll->max_chunk)
+        return 1;
+    return chunk_size >= roll->min_chunk && (hash & roll->boundary_mask) == 0;
+}
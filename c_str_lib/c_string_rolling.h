@@ -0,0 +1,106 @@
+#pragma once
+#ifndef C_STRING_ROLLING_H
+#define C_STRING_ROLLING_H
+
+#include "c_string.h"
+#include "c_string_stream_find.h"
+
+#define MY_STR_ROLLING_MIN_CHUNK (1 << 11)  // default chunking: no boundary in shorter chunks
+#define MY_STR_ROLLING_AVG_CHUNK (1 << 13)  // default chunking: expected size of chunks
+#define MY_STR_ROLLING_MAX_CHUNK (1 << 16)  // default chunking: longer chunks are always cut
+
+// receives start of window equal to the pattern with given id, non zero return stops the scan
+typedef int (*my_str_rolling_match_callback)(size_t position, size_t pattern_id, void* arg);
+
+/*
+ * Rabin-Karp polynomial hash of every window of fixed size, updated in O(1) per byte
+ * hash is computed modulo 2^64, bytes are replaced by random values first, so its high bits
+ * depend on every byte of the window and are used for set lookup and chunk boundaries
+ */
+typedef struct {
+    size_t window;            // size of hashed windows
+    uint64_t power;           // base^window, removes the byte that leaves the window
+    uint64_t table[256];      // random value of every byte
+    // set of patterns of window size
+    my_str_t patterns;        // all patterns one after another, pattern of id starts at id * window
+    size_t patterns_count;
+    uint64_t *set_hashes;     // open addressing by high bits of hash
+    size_t *set_ids;          // pattern id + 1, 0 if slot is empty
+    size_t set_bits;          // set has 2^set_bits slots, 0 if set is empty
+    // content defined chunking
+    size_t min_chunk;
+    size_t max_chunk;
+    uint64_t boundary_mask;   // window ends a chunk when masked high bits of its hash are zero
+} my_str_rolling_t;
+
+/*
+ * prepares rolling hash of windows of given size, chunking is set to default sizes
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if roll is NULL
+ *      RANGE_ERR if window is 0
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_rolling_create(my_str_rolling_t* roll, size_t window);
+
+/*
+ * frees all data of rolling hash and its patterns
+ * return:
+ *     0 always
+ */
+int my_str_rolling_free(my_str_rolling_t* roll);
+
+/*
+ * returns hash of data, for data of window size it is equal to the hash of such window in text
+ * if roll == NULL than hash = 0
+ */
+uint64_t my_str_rolling_hash(const my_str_rolling_t* roll, my_str_view_t data);
+
+/*
+ * computes hashes of all windows of text, hashes[i] is hash of text[i..i + window)
+ * hashes: array of at least text.size_m - window + 1 elements, nothing is written to it
+ *      if text is shorter than window
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if roll or hashes is NULL
+ */
+int my_str_rolling_hashes(const my_str_rolling_t* roll, my_str_view_t text, uint64_t* hashes);
+
+/*
+ * adds pattern of window size to the set searched by my_str_rolling_scan
+ * id: if not NULL, id of pattern is saved there, ids go from 0 in order of adding
+ * return:
+ *      0  if pattern was added
+ *      1  if the same pattern was already added, its id is returned
+ *      NULL_PTR_ERR if roll is NULL or pattern has NULL data
+ *      RANGE_ERR if size of pattern is not equal to window
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_rolling_add_pattern(my_str_rolling_t* roll, my_str_view_t pattern, size_t* id);
+
+/*
+ * sets sizes of chunks for content defined chunking
+ * avg_size is rounded down to power of two, it is expected distance between boundaries
+ * that are found after min_size
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if roll is NULL
+ *      RANGE_ERR if min_size > max_size, max_size is 0 or avg_size is 0
+ */
+int my_str_rolling_set_chunking(my_str_rolling_t* roll, size_t min_size, size_t avg_size, size_t max_size);
+
+/*
+ * rolls hash over text once, reports every window equal to one of patterns (hash match is
+ * verified by comparing bytes) and ends of content defined chunks; the last chunk ends at
+ * the end of text; boundary depends only on the window before it and on the previous
+ * boundary, so changes of text move only boundaries near them
+ * on_match, on_boundary: any of them may be NULL, positions are offsets in text
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if roll is NULL or text has NULL data and non zero size
+ *      else - non zero value returned by callback, rest of text is not scanned
+ */
+int my_str_rolling_scan(const my_str_rolling_t* roll, my_str_view_t text,
+                        my_str_rolling_match_callback on_match, my_str_match_callback on_boundary, void* arg);
+
+#endif // C_STRING_ROLLING_H
@@ -0,0 +1,451 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_rope.h"
+#include "c_string_stream_find.h"
+
+// state of my_rope_find, chunks of the rope are fed to the streaming search
+typedef struct {
+    my_str_stream_find_t stream;
+    size_t position;
+} rope_find_t;
+
+static size_t node_size(const my_rope_node_t* node);
+static void update(my_rope_node_t* node);
+static my_rope_node_t* new_node(my_rope_t* rope);
+static void free_tree(my_rope_node_t* node);
+static my_rope_node_t* merge(my_rope_node_t* left, my_rope_node_t* right);
+static void split(my_rope_node_t* node, size_t pos, my_rope_node_t** left, my_rope_node_t** right,
+                  my_rope_node_t** spare);
+static my_rope_node_t* pop_first(my_rope_node_t* node);
+static my_rope_node_t* join(my_rope_node_t* left, my_rope_node_t* right);
+static my_rope_node_t* locate(my_rope_node_t* node, size_t pos, int at_end, size_t* offset);
+static void add_on_path(my_rope_node_t* node, size_t pos, const my_rope_node_t* target, size_t delta);
+static int visit(const my_rope_node_t* node, size_t start, size_t from, size_t to,
+                 my_str_chunk_callback callback, void* arg);
+static int copy_chunk(const char* chunk, size_t size, void* arg);
+static int feed_chunk(const char* chunk, size_t size, void* arg);
+static int save_first(size_t position, void* arg);
+
+/*
+ * creates empty rope
+ * !important! user should always use my_rope_create before using ANY other rope function
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope is NULL
+ */
+int my_rope_create(my_rope_t* rope) {
+    if (!rope)
+        return NULL_PTR_ERR;
+
+    rope->root = NULL;
+    // any non zero state works for xorshift, address makes priorities differ between ropes
+    rope->seed = ((uint64_t) (uintptr_t) rope) ^ 0x9E3779B97F4A7C15ull;
+    return 0;
+}
+
+/*
+ * frees all chunks of the rope
+ * return:
+ *     0 always
+ */
+int my_rope_free(my_rope_t* rope) {
+    if (!rope)
+        return 0;
+
+    free_tree(rope->root);
+    rope->root = NULL;
+    return 0;
+}
+
+/*
+ * returns size of the rope
+ * if rope == NULL than size = 0
+ */
+size_t my_rope_size(const my_rope_t* rope) {
+    if (!rope)
+        return 0;
+    return node_size(rope->root);
+}
+
+/*
+ * inserts data before given position, pos == size appends it
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope is NULL or data has NULL data and non zero size
+ *      RANGE_ERR if pos is bigger than size of the rope
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation, rope is not changed
+ */
+int my_rope_insert(my_rope_t* rope, size_t pos, my_str_view_t data) {
+    if (!rope || (!data.data && data.size_m))
+        return NULL_PTR_ERR;
+    if (pos > node_size(rope->root))
+        return RANGE_ERR;
+    if (!data.size_m)
+        return 0;
+
+    // small insert goes into the chunk at pos if it has enough free space
+    size_t offset = 0;
+    my_rope_node_t* target = locate(rope->root, pos, 1, &offset);
+    if (target && target->chunk_size + data.size_m <= MY_ROPE_CHUNK) {
+        add_on_path(rope->root, pos, target, data.size_m);
+        memmove(target->chunk + offset + data.size_m, target->chunk + offset, target->chunk_size - offset);
+        memcpy(target->chunk + offset, data.data, data.size_m);
+        target->chunk_size += data.size_m;
+        update(target);
+        return 0;
+    }
+
+    // all memory is taken before the tree is changed
+    my_rope_node_t *spare = new_node(rope), *middle = NULL;
+    if (!spare)
+        return MEMORY_ALLOCATION_ERR;
+    for (size_t done = 0; done < data.size_m; done += MY_ROPE_CHUNK) {
+        my_rope_node_t* node = new_node(rope);
+        if (!node) {
+            free_tree(middle);
+            free(spare);
+            return MEMORY_ALLOCATION_ERR;
+        }
+        node->chunk_size = data.size_m - done < MY_ROPE_CHUNK ? data.size_m - done : MY_ROPE_CHUNK;
+        memcpy(node->chunk, data.data + done, node->chunk_size);
+        update(node);
+        middle = merge(middle, node);
+    }
+
+    my_rope_node_t *left = NULL, *right = NULL;
+    split(rope->root, pos, &left, &right, &spare);
+    free(spare);
+    rope->root = join(join(left, middle), right);
+    return 0;
+}
+
+/*
+ * erases size bytes beginning from pos, or less if the rope ends earlier
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope is NULL
+ *      RANGE_ERR if pos is bigger than size of the rope
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation, rope is not changed
+ */
+int my_rope_erase(my_rope_t* rope, size_t pos, size_t size) {
+    if (!rope)
+        return NULL_PTR_ERR;
+    size_t total = node_size(rope->root);
+    if (pos > total)
+        return RANGE_ERR;
+    if (size > total - pos)
+        size = total - pos;
+    if (!size)
+        return 0;
+
+    // erase inside one chunk that does not empty it is done in place
+    size_t offset = 0;
+    my_rope_node_t* target = locate(rope->root, pos, 0, &offset);
+    if (target && offset + size <= target->chunk_size && size < target->chunk_size) {
+        add_on_path(rope->root, pos, target, 0 - size);
+        memmove(target->chunk + offset, target->chunk + offset + size, target->chunk_size - offset - size);
+        target->chunk_size -= size;
+        update(target);
+        return 0;
+    }
+
+    // every split may cut one chunk in two
+    my_rope_node_t *first_spare = new_node(rope), *second_spare = new_node(rope);
+    if (!first_spare || !second_spare) {
+        free(first_spare);
+        free(second_spare);
+        return MEMORY_ALLOCATION_ERR;
+    }
+
+    my_rope_node_t *left = NULL, *rest = NULL, *middle = NULL, *right = NULL;
+    split(rope->root, pos, &left, &rest, &first_spare);
+    split(rest, size, &middle, &right, &second_spare);
+    free_tree(middle);
+    free(first_spare);
+    free(second_spare);
+    rope->root = join(left, right);
+    return 0;
+}
+
+/*
+ * saves byte at given position to c
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope or c is NULL
+ *      RANGE_ERR if pos is bad
+ */
+int my_rope_get(const my_rope_t* rope, size_t pos, char* c) {
+    if (!rope || !c)
+        return NULL_PTR_ERR;
+    if (pos >= node_size(rope->root))
+        return RANGE_ERR;
+
+    size_t offset = 0;
+    my_rope_node_t* node = locate(rope->root, pos, 0, &offset);
+    *c = node->chunk[offset];
+    return 0;
+}
+
+/*
+ * calls callback for every chunk of bytes [pos, pos + size) in order, or less if the rope
+ * ends earlier; chunks are valid until the next change of the rope
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope or callback is NULL
+ *      RANGE_ERR if pos is bigger than size of the rope
+ *      else - non zero value returned by callback, next chunks are not visited
+ */
+int my_rope_for_each(const my_rope_t* rope, size_t pos, size_t size, my_str_chunk_callback callback, void* arg) {
+    if (!rope || !callback)
+        return NULL_PTR_ERR;
+    size_t total = node_size(rope->root);
+    if (pos > total)
+        return RANGE_ERR;
+    if (size > total - pos)
+        size = total - pos;
+
+    return visit(rope->root, 0, pos, pos + size, callback, arg);
+}
+
+/*
+ * finds the first occurrence of the pattern that begins at from or later, also across chunks
+ * return:
+ *      0  if OK, position is saved to pos
+ *      NOT_FOUND_CODE if there is no such pattern (empty pattern is never found)
+ *      NULL_PTR_ERR if rope or pos is NULL
+ *      RANGE_ERR if from is bigger than size of the rope
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_rope_find(const my_rope_t* rope, size_t from, my_str_view_t pattern, size_t* pos) {
+    if (!rope || !pos)
+        return NULL_PTR_ERR;
+    if (from > node_size(rope->root))
+        return RANGE_ERR;
+
+    rope_find_t find;
+    int err = my_str_stream_find_create(&find.stream, pattern);
+    if (err != 0) return err;
+
+    err = visit(rope->root, 0, from, node_size(rope->root), feed_chunk, &find);
+    my_str_stream_find_free(&find.stream);
+    if (err != 1)
+        return NOT_FOUND_CODE;
+
+    *pos = from + find.position;
+    return 0;
+}
+
+/*
+ * copies whole rope into my_str-string, its buffer is resized once if needed
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope or str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_rope_to_str(const my_rope_t* rope, my_str_t* str) {
+    if (!rope || !str)
+        return NULL_PTR_ERR;
+
+    // old content is not needed, so it is not copied by reserve
+    str->size_m = 0;
+    str->hash_m = 0;
+    int err = my_str_reserve(str, node_size(rope->root));
+    if (err != 0) return err;
+
+    visit(rope->root, 0, 0, node_size(rope->root), copy_chunk, str);
+    return 0;
+}
+
+static size_t node_size(const my_rope_node_t* node) {
+    return node ? node->size_m : 0;
+}
+
+static void update(my_rope_node_t* node) {
+    node->size_m = node_size(node->left) + node->chunk_size + node_size(node->right);
+}
+
+// empty node with the next priority of xorshift generator
+static my_rope_node_t* new_node(my_rope_t* rope) {
+    my_rope_node_t* node = (my_rope_node_t *) malloc(sizeof(my_rope_node_t));
+    if (!node)
+        return NULL;
+
+    rope->seed ^= rope->seed << 13;
+    rope->seed ^= rope->seed >> 7;
+    rope->seed ^= rope->seed << 17;
+    node->priority = rope->seed;
+    node->left = node->right = NULL;
+    node->size_m = node->chunk_size = 0;
+    return node;
+}
+
+static void free_tree(my_rope_node_t* node) {
+    while (node) {
+        free_tree(node->left);
+        my_rope_node_t* right = node->right;
+        free(node);
+        node = right;
+    }
+}
+
+// tree with all chunks of left followed by all chunks of right
+static my_rope_node_t* merge(my_rope_node_t* left, my_rope_node_t* right) {
+    if (!left)
+        return right;
+    if (!right)
+        return left;
+
+    if (left->priority > right->priority) {
+        left->right = merge(left->right, right);
+        update(left);
+        return left;
+    }
+    right->left = merge(left, right->left);
+    update(right);
+    return right;
+}
+
+// divides tree into the first pos bytes and the rest, chunk with pos inside is cut in two
+// and its tail is moved to *spare, which is then set to NULL
+static void split(my_rope_node_t* node, size_t pos, my_rope_node_t** left, my_rope_node_t** right,
+                  my_rope_node_t** spare) {
+    if (!node) {
+        *left = *right = NULL;
+        return;
+    }
+
+    size_t left_size = node_size(node->left);
+    if (pos <= left_size) {
+        split(node->left, pos, left, &node->left, spare);
+        update(node);
+        *right = node;
+    } else if (pos >= left_size + node->chunk_size) {
+        split(node->right, pos - left_size - node->chunk_size, &node->right, right, spare);
+        update(node);
+        *left = node;
+    } else {
+        size_t offset = pos - left_size;
+        // tail gets the priority of the cut node, so heap order holds in the right part
+        my_rope_node_t* tail = *spare;
+        *spare = NULL;
+        tail->priority = node->priority;
+        tail->chunk_size = node->chunk_size - offset;
+        memcpy(tail->chunk, node->chunk + offset, tail->chunk_size);
+        update(tail);
+
+        *right = merge(tail, node->right);
+        node->right = NULL;
+        node->chunk_size = offset;
+        update(node);
+        *left = node;
+    }
+}
+
+// removes the first node of the tree
+static my_rope_node_t* pop_first(my_rope_node_t* node) {
+    if (!node->left) {
+        my_rope_node_t* right = node->right;
+        free(node);
+        return right;
+    }
+    node->left = pop_first(node->left);
+    update(node);
+    return node;
+}
+
+// merges trees, chunks that meet at the edge are combined if they fit in one,
+// so edits do not leave the rope made of tiny chunks
+static my_rope_node_t* join(my_rope_node_t* left, my_rope_node_t* right) {
+    if (!left || !right)
+        return merge(left, right);
+
+    my_rope_node_t *last = left, *first = right;
+    while (last->right)
+        last = last->right;
+    while (first->left)
+        first = first->left;
+
+    if (last->chunk_size + first->chunk_size <= MY_ROPE_CHUNK) {
+        size_t moved = first->chunk_size;
+        memcpy(last->chunk + last->chunk_size, first->chunk, moved);
+        last->chunk_size += moved;
+        for (my_rope_node_t* node = left; node; node = node->right)
+            node->size_m += moved;
+        right = pop_first(right);
+    }
+    return merge(left, right);
+}
+
+// node whose chunk has byte pos, offset in the chunk is saved to offset;
+// if at_end is set, position right after a chunk belongs to it too
+static my_rope_node_t* locate(my_rope_node_t* node, size_t pos, int at_end, size_t* offset) {
+    while (node) {
+        size_t left_size = node_size(node->left);
+        if (pos < left_size) {
+            node = node->left;
+        } else if (pos - left_size < node->chunk_size + (at_end ? 1 : 0)) {
+            *offset = pos - left_size;
+            return node;
+        } else {
+            pos -= left_size + node->chunk_size;
+            node = node->right;
+        }
+    }
+    return NULL;
+}
+
+// adds delta (may wrap to subtract) to sizes of nodes on the path to target found by locate
+static void add_on_path(my_rope_node_t* node, size_t pos, const my_rope_node_t* target, size_t delta) {
+    while (node != target) {
+        size_t left_size = node_size(node->left);
+        node->size_m += delta;
+        if (pos < left_size) {
+            node = node->left;
+        } else {
+            pos -= left_size + node->chunk_size;
+            node = node->right;
+        }
+    }
+}
+
+// calls callback for parts of chunks in [from, to), start - position of the subtree in the rope
+static int visit(const my_rope_node_t* node, size_t start, size_t from, size_t to,
+                 my_str_chunk_callback callback, void* arg) {
+    while (node && start < to && start + node->size_m > from) {
+        int res = visit(node->left, start, from, to, callback, arg);
+        if (res)
+            return res;
+
+        size_t chunk_start = start + node_size(node->left);
+        size_t chunk_end = chunk_start + node->chunk_size;
+        size_t low = from > chunk_start ? from : chunk_start;
+        size_t high = to < chunk_end ? to : chunk_end;
+        if (low < high) {
+            res = callback(node->chunk + (low - chunk_start), high - low, arg);
+            if (res)
+                return res;
+        }
+
+        start = chunk_end;
+        node = node->right;
+    }
+    return 0;
+}
+
+static int copy_chunk(const char* chunk, size_t size, void* arg) {
+    my_str_t* str = (my_str_t *) arg;
+    memcpy(str->data + str->size_m, chunk, size);
+    str->size_m += size;
+    return 0;
+}
+
+static int feed_chunk(const char* chunk, size_t size, void* arg) {
+    rope_find_t* find = (rope_find_t *) arg;
+    my_str_view_t view = {chunk, size};
+    return my_str_stream_find_feed(&find->stream, view, save_first, find);
+}
+
+static int save_first(size_t position, void* arg) {
+    ((rope_find_t *) arg)->position = position;
+    return 1;
+}
@@ -0,0 +1,110 @@
+#pragma once
+#ifndef C_STRING_ROPE_H
+#define C_STRING_ROPE_H
+
+#include "c_string.h"
+
+#define MY_ROPE_CHUNK 2048 // capacity of every chunk, smaller inserts are done in place
+
+// node of the tree, keeps one chunk of text, the text of rope is chunks in order of nodes
+typedef struct my_rope_node {
+    struct my_rope_node *left;
+    struct my_rope_node *right;
+    uint64_t priority;        // heap order of priorities keeps the tree balanced (treap)
+    size_t size_m;            // bytes in this subtree
+    size_t chunk_size;        // bytes in own chunk
+    char chunk[MY_ROPE_CHUNK];
+} my_rope_node_t;
+
+/*
+ * string kept as a balanced tree of chunks (implicit treap), so insert and erase at any
+ * position take O(log n) instead of moving the rest of the string
+ */
+typedef struct {
+    my_rope_node_t *root;
+    uint64_t seed;            // state of generator of priorities
+} my_rope_t;
+
+/*
+ * creates empty rope
+ * !important! user should always use my_rope_create before using ANY other rope function
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope is NULL
+ */
+int my_rope_create(my_rope_t* rope);
+
+/*
+ * frees all chunks of the rope
+ * return:
+ *     0 always
+ */
+int my_rope_free(my_rope_t* rope);
+
+/*
+ * returns size of the rope
+ * if rope == NULL than size = 0
+ */
+size_t my_rope_size(const my_rope_t* rope);
+
+/*
+ * inserts data before given position, pos == size appends it
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope is NULL or data has NULL data and non zero size
+ *      RANGE_ERR if pos is bigger than size of the rope
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation, rope is not changed
+ */
+int my_rope_insert(my_rope_t* rope, size_t pos, my_str_view_t data);
+
+/*
+ * erases size bytes beginning from pos, or less if the rope ends earlier
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope is NULL
+ *      RANGE_ERR if pos is bigger than size of the rope
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation, rope is not changed
+ */
+int my_rope_erase(my_rope_t* rope, size_t pos, size_t size);
+
+/*
+ * saves byte at given position to c
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope or c is NULL
+ *      RANGE_ERR if pos is bad
+ */
+int my_rope_get(const my_rope_t* rope, size_t pos, char* c);
+
+/*
+ * calls callback for every chunk of bytes [pos, pos + size) in order, or less if the rope
+ * ends earlier; chunks are valid until the next change of the rope
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope or callback is NULL
+ *      RANGE_ERR if pos is bigger than size of the rope
+ *      else - non zero value returned by callback, next chunks are not visited
+ */
+int my_rope_for_each(const my_rope_t* rope, size_t pos, size_t size, my_str_chunk_callback callback, void* arg);
+
+/*
+ * finds the first occurrence of the pattern that begins at from or later, also across chunks
+ * return:
+ *      0  if OK, position is saved to pos
+ *      NOT_FOUND_CODE if there is no such pattern (empty pattern is never found)
+ *      NULL_PTR_ERR if rope or pos is NULL
+ *      RANGE_ERR if from is bigger than size of the rope
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_rope_find(const my_rope_t* rope, size_t from, my_str_view_t pattern, size_t* pos);
+
+/*
+ * copies whole rope into my_str-string, its buffer is resized once if needed
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if rope or str is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_rope_to_str(const my_rope_t* rope, my_str_t* str);
+
+#endif // C_STRING_ROPE_H
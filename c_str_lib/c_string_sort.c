@@ -0,0 +1,301 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_sort.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#define INSERTION_SORT_MAX 24 // smaller parts are sorted by insertion
+#define BUCKETS 257           // bucket 0 keeps strings that ended, bucket b + 1 - byte b
+
+// string being sorted and its position in the input array
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+    size_t index;
+} sort_key_t;
+
+// state shared by threads of parallel sort, each thread takes the next bucket
+typedef struct {
+    sort_key_t* keys;
+    sort_key_t* aux;
+    size_t starts[BUCKETS + 1];
+    size_t next_bucket;
+    int stable;
+    pthread_mutex_t lock;
+} parallel_sort_t;
+
+static int sort_keys(sort_key_t* keys, size_t count, int flags);
+static void multikey_quicksort(sort_key_t* keys, size_t count, size_t depth);
+static void radix_sort(sort_key_t* keys, sort_key_t* aux, size_t count, size_t depth);
+static void distribute(sort_key_t* keys, sort_key_t* aux, size_t count, size_t depth, size_t* starts);
+static void insertion_sort(sort_key_t* keys, size_t count, size_t depth);
+static int parallel_sort(sort_key_t* keys, sort_key_t* aux, size_t count, int stable);
+static void* parallel_sort_worker(void* arg);
+
+/*
+ * sorts array of my_str-strings in lexicographical order of unsigned bytes (like memcmp,
+ * a prefix goes before longer string); for ASCII strings the order is the same as my_str_cmp
+ * without flags multikey quicksort is used, so common prefixes are not compared again and again
+ * flags: combination of MY_STR_SORT_STABLE and MY_STR_SORT_PARALLEL, or 0
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if strs is NULL and count is not 0
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_sort(my_str_t* strs, size_t count, int flags) {
+    if (!strs && count)
+        return NULL_PTR_ERR;
+
+    if (count < 2)
+        return 0;
+
+    sort_key_t* keys = (sort_key_t *) malloc(count * sizeof(sort_key_t));
+    my_str_t* sorted = (my_str_t *) malloc(count * sizeof(my_str_t));
+    if (!keys || !sorted) {
+        free(keys);
+        free(sorted);
+        return MEMORY_ALLOCATION_ERR;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        keys[i].data = (const unsigned char *) strs[i].data;
+        keys[i].size = strs[i].size_m;
+        keys[i].index = i;
+    }
+
+    int err = sort_keys(keys, count, flags);
+    if (err == 0) {
+        // the strings themselves are moved, their buffers stay where they are
+        for (size_t i = 0; i < count; i++)
+            sorted[i] = strs[keys[i].index];
+        memcpy(strs, sorted, count * sizeof(my_str_t));
+    }
+
+    free(keys);
+    free(sorted);
+    return err;
+}
+
+/*
+ * sorts array of views, the same as my_str_sort
+ * return:
+ *      the same as in my_str_sort(...) function
+ */
+int my_str_sort_views(my_str_view_t* views, size_t count, int flags) {
+    if (!views && count)
+        return NULL_PTR_ERR;
+
+    if (count < 2)
+        return 0;
+
+    sort_key_t* keys = (sort_key_t *) malloc(count * sizeof(sort_key_t));
+    if (!keys)
+        return MEMORY_ALLOCATION_ERR;
+
+    for (size_t i = 0; i < count; i++) {
+        keys[i].data = (const unsigned char *) views[i].data;
+        keys[i].size = views[i].size_m;
+        keys[i].index = i;
+    }
+
+    int err = sort_keys(keys, count, flags);
+    if (err == 0) {
+        for (size_t i = 0; i < count; i++) {
+            views[i].data = (const char *) keys[i].data;
+            views[i].size_m = keys[i].size;
+        }
+    }
+
+    free(keys);
+    return err;
+}
+
+// byte of the key at given depth, -1 if key is shorter
+static int key_at(const sort_key_t* key, size_t depth) {
+    return (depth < key->size) ? key->data[depth] : -1;
+}
+
+// compares keys that are known to be equal before depth
+static int key_cmp(const sort_key_t* a, const sort_key_t* b, size_t depth) {
+    size_t a_left = a->size - depth, b_left = b->size - depth;
+    size_t n = (a_left < b_left) ? a_left : b_left;
+    int res = n ? memcmp(a->data + depth, b->data + depth, n) : 0;
+    if (res != 0)
+        return res;
+
+    return (a_left < b_left) ? -1 : (a_left > b_left);
+}
+
+static void swap_keys(sort_key_t* a, sort_key_t* b) {
+    sort_key_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static int sort_keys(sort_key_t* keys, size_t count, int flags) {
+    int stable = (flags & MY_STR_SORT_STABLE) != 0;
+    int parallel = (flags & MY_STR_SORT_PARALLEL) && count >= MY_STR_SORT_PARALLEL_MIN;
+    if (!stable && !parallel) {
+        multikey_quicksort(keys, count, 0);
+        return 0;
+    }
+
+    sort_key_t* aux = (sort_key_t *) malloc(count * sizeof(sort_key_t));
+    if (!aux)
+        return MEMORY_ALLOCATION_ERR;
+
+    int err = 0;
+    if (parallel)
+        err = parallel_sort(keys, aux, count, stable);
+    else
+        radix_sort(keys, aux, count, 0);
+
+    free(aux);
+    return err;
+}
+
+// Bentley-Sedgewick three way radix quicksort on the byte at depth
+static void multikey_quicksort(sort_key_t* keys, size_t count, size_t depth) {
+    while (count > INSERTION_SORT_MAX) {
+        // median of three bytes is the pivot
+        int a = key_at(&keys[0], depth), b = key_at(&keys[count / 2], depth), c = key_at(&keys[count - 1], depth);
+        int pivot = (a < b) ? ((b < c) ? b : (a < c ? c : a)) : ((a < c) ? a : (b < c ? c : b));
+
+        // [0, lt) < pivot, [lt, i) == pivot, (gt, count) > pivot
+        size_t lt = 0, i = 0, gt = count;
+        while (i < gt) {
+            int byte = key_at(&keys[i], depth);
+            if (byte < pivot)
+                swap_keys(&keys[lt++], &keys[i++]);
+            else if (byte > pivot)
+                swap_keys(&keys[i], &keys[--gt]);
+            else
+                i++;
+        }
+
+        multikey_quicksort(keys, lt, depth);
+        multikey_quicksort(keys + gt, count - gt, depth);
+
+        // equal part continues with the next byte, unless all its strings ended
+        if (pivot < 0)
+            return;
+        keys += lt;
+        count = gt - lt;
+        depth++;
+    }
+
+    insertion_sort(keys, count, depth);
+}
+
+// most significant digit first radix sort, every pass is stable
+static void radix_sort(sort_key_t* keys, sort_key_t* aux, size_t count, size_t depth) {
+    size_t starts[BUCKETS + 1];
+
+    while (count > INSERTION_SORT_MAX) {
+        distribute(keys, aux, count, depth, starts);
+
+        // the largest bucket is sorted by the loop, others by recursion, so every recursive
+        // call gets at most half of the keys and depth of recursion stays O(log count)
+        size_t largest = 0;
+        for (size_t b = 1; b < BUCKETS; b++)
+            if (starts[b + 1] - starts[b] > starts[largest + 1] - starts[largest])
+                largest = b;
+
+        for (size_t b = 1; b < BUCKETS; b++)
+            if (b != largest && starts[b + 1] - starts[b] > 1)
+                radix_sort(keys + starts[b], aux + starts[b], starts[b + 1] - starts[b], depth + 1);
+
+        // strings that ended are equal and already in input order
+        if (largest == 0)
+            return;
+        keys += starts[largest];
+        aux += starts[largest];
+        count = starts[largest + 1] - starts[largest];
+        depth++;
+    }
+
+    insertion_sort(keys, count, depth);
+}
+
+// stable counting sort by the byte at depth, starts[b] is the beginning of bucket b
+static void distribute(sort_key_t* keys, sort_key_t* aux, size_t count, size_t depth, size_t* starts) {
+    size_t counts[BUCKETS] = {0};
+    for (size_t i = 0; i < count; i++)
+        counts[key_at(&keys[i], depth) + 1]++;
+
+    starts[0] = 0;
+    for (size_t b = 0; b < BUCKETS; b++)
+        starts[b + 1] = starts[b] + counts[b];
+
+    size_t next[BUCKETS];
+    memcpy(next, starts, sizeof(next));
+    for (size_t i = 0; i < count; i++)
+        aux[next[key_at(&keys[i], depth) + 1]++] = keys[i];
+    memcpy(keys, aux, count * sizeof(sort_key_t));
+}
+
+// stable, keys are known to be equal before depth
+static void insertion_sort(sort_key_t* keys, size_t count, size_t depth) {
+    for (size_t i = 1; i < count; i++) {
+        sort_key_t key = keys[i];
+        size_t j = i;
+        for (; j > 0 && key_cmp(&keys[j - 1], &key, depth) > 0; j--)
+            keys[j] = keys[j - 1];
+        keys[j] = key;
+    }
+}
+
+// distributes keys by the first byte and sorts the buckets on several threads
+static int parallel_sort(sort_key_t* keys, sort_key_t* aux, size_t count, int stable) {
+    parallel_sort_t sort;
+    sort.keys = keys;
+    sort.aux = aux;
+    sort.next_bucket = 1; // strings that are empty are already sorted
+    sort.stable = stable;
+    distribute(keys, aux, count, 0, sort.starts);
+
+    if (pthread_mutex_init(&sort.lock, NULL) != 0)
+        return MEMORY_ALLOCATION_ERR;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threads = (cpus > 1) ? (size_t) cpus : 1;
+    threads = (threads < BUCKETS) ? threads : BUCKETS;
+
+    // the calling thread is one of the workers
+    pthread_t workers[BUCKETS];
+    size_t started = 0;
+    for (; started < threads - 1; started++)
+        if (pthread_create(&workers[started], NULL, parallel_sort_worker, &sort) != 0)
+            break;
+
+    parallel_sort_worker(&sort);
+    for (size_t i = 0; i < started; i++)
+        pthread_join(workers[i], NULL);
+
+    pthread_mutex_destroy(&sort.lock);
+    return 0;
+}
+
+static void* parallel_sort_worker(void* arg) {
+    parallel_sort_t* sort = (parallel_sort_t *) arg;
+
+    for (;;) {
+        pthread_mutex_lock(&sort->lock);
+        size_t b = sort->next_bucket++;
+        pthread_mutex_unlock(&sort->lock);
+        if (b >= BUCKETS)
+            break;
+
+        size_t start = sort->starts[b], size = sort->starts[b + 1] - start;
+        if (size < 2)
+            continue;
+
+        if (sort->stable)
+            radix_sort(sort->keys + start, sort->aux + start, size, 1);
+        else
+            multikey_quicksort(sort->keys + start, size, 1);
+    }
+
+    return NULL;
+}
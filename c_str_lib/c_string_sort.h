@@ -0,0 +1,30 @@
+#pragma once
+#ifndef C_STRING_SORT_H
+#define C_STRING_SORT_H
+
+#include "c_string.h"
+
+#define MY_STR_SORT_STABLE 1              // keeps order of equal strings (MSD radix sort)
+#define MY_STR_SORT_PARALLEL 2            // sorts buckets of the first byte on all CPUs
+#define MY_STR_SORT_PARALLEL_MIN (1 << 16) // smaller arrays are always sorted in one thread
+
+/*
+ * sorts array of my_str-strings in lexicographical order of unsigned bytes (like memcmp,
+ * a prefix goes before longer string); for ASCII strings the order is the same as my_str_cmp
+ * without flags multikey quicksort is used, so common prefixes are not compared again and again
+ * flags: combination of MY_STR_SORT_STABLE and MY_STR_SORT_PARALLEL, or 0
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if strs is NULL and count is not 0
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_sort(my_str_t* strs, size_t count, int flags);
+
+/*
+ * sorts array of views, the same as my_str_sort
+ * return:
+ *      the same as in my_str_sort(...) function
+ */
+int my_str_sort_views(my_str_view_t* views, size_t count, int flags);
+
+#endif // C_STRING_SORT_H
@@ -0,0 +1,127 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_stream_find.h"
+
+/*
+ * prepares streaming search for given pattern
+ * only pattern-sized state is kept between chunks, so matches spanning chunk edges are found
+ * without buffering the data
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if state is NULL or pattern has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_stream_find_create(my_str_stream_find_t* state, my_str_view_t pattern) {
+    if (!state || (!pattern.data && pattern.size_m))
+        return NULL_PTR_ERR;
+
+    memset(state, 0, sizeof(*state));
+    if (pattern.size_m == 0)
+        return 0;
+
+    state->pattern = (char *) malloc(pattern.size_m);
+    state->borders = (size_t *) malloc(pattern.size_m * sizeof(size_t));
+    if (!state->pattern || !state->borders) {
+        my_str_stream_find_free(state);
+        return MEMORY_ALLOCATION_ERR;
+    }
+
+    memcpy(state->pattern, pattern.data, pattern.size_m);
+    state->size_m = pattern.size_m;
+
+    // Knuth-Morris-Pratt failure function
+    state->borders[0] = 0;
+    size_t k = 0;
+    for (size_t i = 1; i < pattern.size_m; i++) {
+        while (k > 0 && state->pattern[i] != state->pattern[k])
+            k = state->borders[k - 1];
+        if (state->pattern[i] == state->pattern[k])
+            k++;
+        state->borders[i] = k;
+    }
+
+    return 0;
+}
+
+/*
+ * frees all data of the streaming search
+ * return:
+ *     0 always
+ */
+int my_str_stream_find_free(my_str_stream_find_t* state) {
+    if (!state)
+        return 0;
+
+    free(state->pattern);
+    free(state->borders);
+    memset(state, 0, sizeof(*state));
+
+    return 0;
+}
+
+/*
+ * forgets all fed data, next chunk is treated as the beginning at offset 0
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if state is NULL
+ */
+int my_str_stream_find_reset(my_str_stream_find_t* state) {
+    if (!state)
+        return NULL_PTR_ERR;
+
+    state->matched = 0;
+    state->position = 0;
+
+    return 0;
+}
+
+/*
+ * feeds the next chunk of data and reports start of every match (overlapping ones too)
+ * by its absolute offset among all fed data; empty pattern never matches
+ * chunks must not repeat data, so for chunks of my_str_chunk_reader the first
+ * chunk.overlap bytes should be skipped
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if state or callback is NULL
+ *      else - non zero value returned by callback, rest of the chunk is not searched
+ */
+int my_str_stream_find_feed(my_str_stream_find_t* state, my_str_view_t chunk,
+                            my_str_match_callback callback, void* arg) {
+    if (!state || !callback)
+        return NULL_PTR_ERR;
+
+    size_t base = state->position;
+    state->position += chunk.size_m;
+    if (state->size_m == 0 || !chunk.data)
+        return 0;
+
+    const char* pattern = state->pattern;
+    size_t matched = state->matched;
+    for (size_t i = 0; i < chunk.size_m; i++) {
+        // nothing is matched yet, so jump straight to the next candidate
+        if (matched == 0) {
+            const char* next = (const char *) memchr(chunk.data + i, pattern[0], chunk.size_m - i);
+            if (!next)
+                break;
+            i = (size_t) (next - chunk.data);
+        }
+
+        char c = chunk.data[i];
+        while (matched > 0 && pattern[matched] != c)
+            matched = state->borders[matched - 1];
+        if (pattern[matched] == c)
+            matched++;
+
+        if (matched == state->size_m) {
+            matched = state->borders[matched - 1];
+            int err = callback(base + i + 1 - state->size_m, arg);
+            if (err != 0) {
+                state->matched = 0;
+                return err;
+            }
+        }
+    }
+
+    state->matched = matched;
+    return 0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef C_STRING_STREAM_FIND_H
+#define C_STRING_STREAM_FIND_H
+
+#include "c_string.h"
+
+// receives absolute position of every match, non zero return stops the search
+typedef int (*my_str_match_callback)(size_t position, void* arg);
+
+// state of substring search over data that comes in successive chunks
+typedef struct {
+    char *pattern;    // Own copy of the pattern
+    size_t size_m;    // Size of the pattern
+    size_t *borders;  // borders[i] - length of the longest proper border of pattern[0..i]
+    size_t matched;   // length of pattern prefix that ends the data fed so far
+    size_t position;  // absolute offset of the next fed byte
+} my_str_stream_find_t;
+
+/*
+ * prepares streaming search for given pattern
+ * only pattern-sized state is kept between chunks, so matches spanning chunk edges are found
+ * without buffering the data
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if state is NULL or pattern has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_stream_find_create(my_str_stream_find_t* state, my_str_view_t pattern);
+
+/*
+ * frees all data of the streaming search
+ * return:
+ *     0 always
+ */
+int my_str_stream_find_free(my_str_stream_find_t* state);
+
+/*
+ * forgets all fed data, next chunk is treated as the beginning at offset 0
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if state is NULL
+ */
+int my_str_stream_find_reset(my_str_stream_find_t* state);
+
+/*
+ * feeds the next chunk of data and reports start of every match (overlapping ones too)
+ * by its absolute offset among all fed data; empty pattern never matches
+ * chunks must not repeat data, so for chunks of my_str_chunk_reader the first
+ * chunk.overlap bytes should be skipped
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if state or callback is NULL
+ *      else - non zero value returned by callback, rest of the chunk is not searched
+ */
+int my_str_stream_find_feed(my_str_stream_find_t* state, my_str_view_t chunk,
+                            my_str_match_callback callback, void* arg);
+
+#endif // C_STRING_STREAM_FIND_H
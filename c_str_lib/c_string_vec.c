@@ -0,0 +1,287 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#include "c_string_vec.h"
+
+static int reserve_strings(my_str_vec_t* vec, size_t capacity);
+static int reserve_bytes(my_str_vec_t* vec, size_t extra);
+
+/*
+ * creates empty vector of strings
+ * !important! user should always use my_str_vec_create before using ANY other vector function
+ * capacity: number of strings that can be appended without growing
+ * bytes_capacity: number of bytes that can be appended without growing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_vec_create(my_str_vec_t* vec, size_t capacity, size_t bytes_capacity) {
+    if (!vec)
+        return NULL_PTR_ERR;
+
+    if (capacity > SIZE_MAX / sizeof(size_t) - 1)
+        return MEMORY_ALLOCATION_ERR;
+
+    vec->offsets = (size_t *) malloc((capacity + 1) * sizeof(size_t));
+    if (!vec->offsets)
+        return MEMORY_ALLOCATION_ERR;
+
+    int err = my_str_create(&vec->blob, bytes_capacity);
+    if (err != 0) {
+        free(vec->offsets);
+        vec->offsets = NULL;
+        return err;
+    }
+
+    vec->offsets[0] = 0;
+    vec->size_m = 0;
+    vec->capacity_m = capacity;
+
+    return 0;
+}
+
+/*
+ * frees all data of the vector
+ * return:
+ *     0 always
+ */
+int my_str_vec_free(my_str_vec_t* vec) {
+    if (!vec)
+        return 0;
+
+    my_str_free(&vec->blob);
+    free(vec->offsets);
+    vec->offsets = NULL;
+    vec->size_m = vec->capacity_m = 0;
+
+    return 0;
+}
+
+/*
+ * returns number of strings in the vector
+ * if vec == NULL than size = 0
+ */
+size_t my_str_vec_size(const my_str_vec_t* vec) {
+    return vec ? vec->size_m : 0;
+}
+
+/*
+ * removes all strings, memory is kept for reuse
+ * return:
+ *     0 always
+ */
+int my_str_vec_clear(my_str_vec_t* vec) {
+    if (!vec || !vec->offsets)
+        return 0;
+
+    // blob is reset directly, my_str_clear would zero all its capacity
+    vec->blob.size_m = 0;
+    vec->blob.hash_m = 0;
+    vec->size_m = 0;
+
+    return 0;
+}
+
+/*
+ * appends copy of the string to the end of the vector
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec is NULL or str has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_vec_append(my_str_vec_t* vec, my_str_view_t str) {
+    if (!vec || !vec->offsets || (!str.data && str.size_m))
+        return NULL_PTR_ERR;
+
+    if (vec->size_m == vec->capacity_m) {
+        if (vec->capacity_m > SIZE_MAX / sizeof(size_t) / 2 - 1)
+            return MEMORY_ALLOCATION_ERR;
+        int err = reserve_strings(vec, vec->capacity_m ? vec->capacity_m * 2 : 16);
+        if (err != 0) return err;
+    }
+
+    int err = reserve_bytes(vec, str.size_m);
+    if (err != 0) return err;
+
+    if (str.size_m)
+        memcpy(vec->blob.data + vec->blob.size_m, str.data, str.size_m);
+    vec->blob.size_m += str.size_m;
+    vec->offsets[++vec->size_m] = vec->blob.size_m;
+
+    return 0;
+}
+
+/*
+ * appends copy of my_str-string to the end of the vector
+ * return:
+ *      the same as in my_str_vec_append, NULL_PTR_ERR if str is NULL too
+ */
+int my_str_vec_append_str(my_str_vec_t* vec, const my_str_t* str) {
+    if (!str)
+        return NULL_PTR_ERR;
+
+    return my_str_vec_append(vec, my_str_view(str));
+}
+
+/*
+ * returns view of the string with given index, valid until the next append
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec or str is NULL
+ *      RANGE_ERR if index is bad
+ */
+int my_str_vec_get(const my_str_vec_t* vec, size_t index, my_str_view_t* str) {
+    if (!vec || !vec->offsets || !str)
+        return NULL_PTR_ERR;
+
+    if (index >= vec->size_m)
+        return RANGE_ERR;
+
+    str->data = vec->blob.data + vec->offsets[index];
+    str->size_m = vec->offsets[index + 1] - vec->offsets[index];
+
+    return 0;
+}
+
+/*
+ * replaces content of the vector with parts of text between delimiters
+ * (n delimiters give n + 1 parts, some of them may be empty); memory is allocated once
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec is NULL or text has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_vec_from_split(my_str_vec_t* vec, my_str_view_t text, char delimiter) {
+    if (!vec || !vec->offsets || (!text.data && text.size_m))
+        return NULL_PTR_ERR;
+
+    // the first pass only counts parts, so both arrays are allocated once
+    size_t parts = 1;
+    const char* end = text.data + text.size_m;
+    for (const char* p = text.data; p < end; p++) {
+        p = (const char *) memchr(p, delimiter, (size_t) (end - p));
+        if (!p)
+            break;
+        parts++;
+    }
+
+    my_str_vec_clear(vec);
+    int err = reserve_strings(vec, parts);
+    if (err != 0) return err;
+    err = reserve_bytes(vec, text.size_m - (parts - 1));
+    if (err != 0) return err;
+
+    const char* part = text.data;
+    for (size_t i = 0; i < parts; i++) {
+        const char* next = (i + 1 < parts) ? (const char *) memchr(part, delimiter, (size_t) (end - part)) : end;
+        size_t size = (size_t) (next - part);
+        if (size)
+            memcpy(vec->blob.data + vec->blob.size_m, part, size);
+        vec->blob.size_m += size;
+        vec->offsets[i + 1] = vec->blob.size_m;
+        part = next + 1;
+    }
+    vec->size_m = parts;
+
+    return 0;
+}
+
+/*
+ * looks for the pattern in every string of the vector in a single pass over the blob
+ * positions: array of my_str_vec_size elements, positions[i] is set to the position of the
+ *      first occurrence in string i or to (size_t) NOT_FOUND_CODE; empty pattern is never found
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec or positions is NULL
+ */
+int my_str_vec_find_all(const my_str_vec_t* vec, my_str_view_t pattern, size_t* positions) {
+    if (!vec || !vec->offsets || (!positions && vec->size_m) || (!pattern.data && pattern.size_m))
+        return NULL_PTR_ERR;
+
+    for (size_t i = 0; i < vec->size_m; i++)
+        positions[i] = (size_t) NOT_FOUND_CODE;
+
+    size_t size = vec->blob.size_m;
+    if (!pattern.size_m || pattern.size_m > size)
+        return 0;
+
+    // candidates are found by memchr over the whole blob, offsets tell which string they belong to
+    const char* blob = vec->blob.data;
+    size_t last = size - pattern.size_m;
+    size_t current = 0;
+    size_t pos = 0;
+    while (pos <= last) {
+        const char* candidate = (const char *) memchr(blob + pos, pattern.data[0], last - pos + 1);
+        if (!candidate)
+            break;
+        pos = (size_t) (candidate - blob);
+
+        while (vec->offsets[current + 1] <= pos)
+            current++;
+
+        if (pos + pattern.size_m <= vec->offsets[current + 1] &&
+            memcmp(candidate, pattern.data, pattern.size_m) == 0) {
+            // only the first occurrence is needed, the rest of this string is skipped
+            positions[current] = pos - vec->offsets[current];
+            pos = vec->offsets[current + 1];
+        } else {
+            pos++;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * compares every string of the vector with the key in order of unsigned bytes (like memcmp)
+ * results: array of my_str_vec_size elements, results[i] is set to -1, 0 or 1 like in my_str_cmp
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec or results is NULL
+ */
+int my_str_vec_cmp_all(const my_str_vec_t* vec, my_str_view_t key, int* results) {
+    if (!vec || !vec->offsets || (!results && vec->size_m) || (!key.data && key.size_m))
+        return NULL_PTR_ERR;
+
+    for (size_t i = 0; i < vec->size_m; i++) {
+        size_t size = vec->offsets[i + 1] - vec->offsets[i];
+        size_t n = (size < key.size_m) ? size : key.size_m;
+        int res = n ? memcmp(vec->blob.data + vec->offsets[i], key.data, n) : 0;
+        if (res == 0)
+            res = (size < key.size_m) ? -1 : (size > key.size_m);
+        results[i] = (res > 0) - (res < 0);
+    }
+
+    return 0;
+}
+
+// grows offsets so that capacity strings fit
+static int reserve_strings(my_str_vec_t* vec, size_t capacity) {
+    if (capacity <= vec->capacity_m)
+        return 0;
+
+    if (capacity > SIZE_MAX / sizeof(size_t) - 1)
+        return MEMORY_ALLOCATION_ERR;
+
+    size_t* offsets = (size_t *) realloc(vec->offsets, (capacity + 1) * sizeof(size_t));
+    if (!offsets)
+        return MEMORY_ALLOCATION_ERR;
+
+    vec->offsets = offsets;
+    vec->capacity_m = capacity;
+
+    return 0;
+}
+
+// grows blob geometrically so that extra bytes can be appended
+static int reserve_bytes(my_str_vec_t* vec, size_t extra) {
+    my_str_t* blob = &vec->blob;
+    if (extra <= blob->capacity_m - blob->size_m)
+        return 0;
+
+    if (extra > SIZE_MAX / 2 - blob->size_m)
+        return MEMORY_ALLOCATION_ERR;
+
+    size_t needed = blob->size_m + extra;
+    return my_str_reserve(blob, (needed > blob->capacity_m * 2) ? needed : blob->capacity_m * 2);
+}
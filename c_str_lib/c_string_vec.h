@@ -0,0 +1,104 @@
+#pragma once
+#ifndef C_STRING_VEC_H
+#define C_STRING_VEC_H
+
+#include "c_string.h"
+
+/*
+ * vector of strings stored as a column: bytes of all strings one after another in a single
+ * blob and offsets of their beginnings, so there is no header or allocation per string
+ */
+typedef struct {
+    my_str_t blob;      // bytes of all strings
+    size_t *offsets;    // offsets[i] - beginning of string i, offsets[size_m] - end of the last one
+    size_t size_m;      // number of strings
+    size_t capacity_m;  // number of strings that fit without growing offsets
+} my_str_vec_t;
+
+/*
+ * creates empty vector of strings
+ * !important! user should always use my_str_vec_create before using ANY other vector function
+ * capacity: number of strings that can be appended without growing
+ * bytes_capacity: number of bytes that can be appended without growing
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec is NULL
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_vec_create(my_str_vec_t* vec, size_t capacity, size_t bytes_capacity);
+
+/*
+ * frees all data of the vector
+ * return:
+ *     0 always
+ */
+int my_str_vec_free(my_str_vec_t* vec);
+
+/*
+ * returns number of strings in the vector
+ * if vec == NULL than size = 0
+ */
+size_t my_str_vec_size(const my_str_vec_t* vec);
+
+/*
+ * removes all strings, memory is kept for reuse
+ * return:
+ *     0 always
+ */
+int my_str_vec_clear(my_str_vec_t* vec);
+
+/*
+ * appends copy of the string to the end of the vector
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec is NULL or str has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_vec_append(my_str_vec_t* vec, my_str_view_t str);
+
+/*
+ * appends copy of my_str-string to the end of the vector
+ * return:
+ *      the same as in my_str_vec_append, NULL_PTR_ERR if str is NULL too
+ */
+int my_str_vec_append_str(my_str_vec_t* vec, const my_str_t* str);
+
+/*
+ * returns view of the string with given index, valid until the next append
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec or str is NULL
+ *      RANGE_ERR if index is bad
+ */
+int my_str_vec_get(const my_str_vec_t* vec, size_t index, my_str_view_t* str);
+
+/*
+ * replaces content of the vector with parts of text between delimiters
+ * (n delimiters give n + 1 parts, some of them may be empty); memory is allocated once
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec is NULL or text has NULL data and non zero size
+ *      MEMORY_ALLOCATION_ERR if there was an error during memory allocation
+ */
+int my_str_vec_from_split(my_str_vec_t* vec, my_str_view_t text, char delimiter);
+
+/*
+ * looks for the pattern in every string of the vector in a single pass over the blob
+ * positions: array of my_str_vec_size elements, positions[i] is set to the position of the
+ *      first occurrence in string i or to (size_t) NOT_FOUND_CODE; empty pattern is never found
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec or positions is NULL
+ */
+int my_str_vec_find_all(const my_str_vec_t* vec, my_str_view_t pattern, size_t* positions);
+
+/*
+ * compares every string of the vector with the key in order of unsigned bytes (like memcmp)
+ * results: array of my_str_vec_size elements, results[i] is set to -1, 0 or 1 like in my_str_cmp
+ * return:
+ *      0  if OK
+ *      NULL_PTR_ERR if vec or results is NULL
+ */
+int my_str_vec_cmp_all(const my_str_vec_t* vec, my_str_view_t key, int* results);
+
+#endif // C_STRING_VEC_H
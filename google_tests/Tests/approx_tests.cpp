@@ -0,0 +1,234 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "c_string_approx.h"
+}
+
+namespace {
+    class ApproxDeclaration : public testing::Test {
+    protected:
+        std::mt19937 gen{17};
+
+        std::string random_string(size_t size, const char* alphabet) {
+            std::string result;
+            size_t letters = strlen(alphabet);
+            for (size_t i = 0; i < size; i++)
+                result.push_back(alphabet[gen() % letters]);
+            return result;
+        }
+
+        // copy of str with some random edits
+        std::string mutate(const std::string &str, size_t edits) {
+            std::string result = str;
+            for (size_t i = 0; i < edits && !result.empty(); i++) {
+                size_t pos = gen() % result.size();
+                switch (gen() % 3) {
+                    case 0: result[pos] = 'x'; break;
+                    case 1: result.erase(pos, 1); break;
+                    default: result.insert(pos, 1, 'y');
+                }
+            }
+            return result;
+        }
+
+        // costs of the best match ending after every symbol of text, by plain dynamic programming
+        static std::vector<size_t> naive_search(const std::string &pattern, const std::string &text) {
+            std::vector<size_t> column(pattern.size() + 1), costs;
+            for (size_t i = 0; i <= pattern.size(); i++)
+                column[i] = i;
+            for (char c: text) {
+                size_t diagonal = column[0];
+                for (size_t i = 1; i <= pattern.size(); i++) {
+                    size_t up = column[i];
+                    column[i] = std::min({up + 1, column[i - 1] + 1, diagonal + (pattern[i - 1] != c)});
+                    diagonal = up;
+                }
+                costs.push_back(column[pattern.size()]);
+            }
+            return costs;
+        }
+
+        static size_t naive_distance(const std::string &a, const std::string &b) {
+            std::vector<size_t> row(b.size() + 1);
+            for (size_t j = 0; j <= b.size(); j++)
+                row[j] = j;
+            for (size_t i = 1; i <= a.size(); i++) {
+                size_t diagonal = row[0];
+                row[0] = i;
+                for (size_t j = 1; j <= b.size(); j++) {
+                    size_t up = row[j];
+                    row[j] = std::min({up + 1, row[j - 1] + 1, diagonal + (a[i - 1] != b[j - 1])});
+                    diagonal = up;
+                }
+            }
+            return row[b.size()];
+        }
+
+        static my_str_t make_str(const std::string &content) {
+            my_str_t str;
+            my_str_create(&str, content.size());
+            if (!content.empty())
+                memcpy(str.data, content.data(), content.size());
+            str.size_m = content.size();
+            return str;
+        }
+
+        static int save_match(size_t end, size_t cost, void* arg) {
+            static_cast<std::vector<std::pair<size_t, size_t>> *>(arg)->emplace_back(end, cost);
+            return 0;
+        }
+    };
+}
+
+TEST_F(ApproxDeclaration, my_str_approx_search) {
+    for (size_t size: {1, 5, 63, 64, 65, 130, 600}) {
+        std::string pattern = random_string(size, "acgt");
+        std::string text = random_string(300, "acgt") + mutate(pattern, size / 10 + 1) + random_string(300, "acgt");
+        std::vector<size_t> costs = naive_search(pattern, text);
+
+        my_str_approx_t approx;
+        ASSERT_EQ(my_str_approx_create(&approx, my_str_view_t{pattern.data(), pattern.size()}), 0);
+        for (size_t k: {(size_t) 0, (size_t) 1, size / 10 + 1, size / 3}) {
+            std::vector<std::pair<size_t, size_t>> matches, expected;
+            ASSERT_EQ(my_str_approx_search(&approx, my_str_view_t{text.data(), text.size()}, k, save_match, &matches), 0);
+            for (size_t j = 0; j < costs.size(); j++)
+                if (costs[j] <= k)
+                    expected.emplace_back(j + 1, costs[j]);
+            ASSERT_EQ(matches, expected) << size << " " << k;
+        }
+        my_str_approx_free(&approx);
+    }
+}
+
+TEST_F(ApproxDeclaration, my_str_approx_find) {
+    my_str_t str;
+    my_str_create(&str, 0);
+    my_str_from_cstr(&str, "error: conection refused by host", 0);
+
+    size_t end = 0, cost = 0;
+    ASSERT_EQ(my_str_approx_find(&str, my_str_view_cstr("connection"), 1, &end, &cost), 0);
+    ASSERT_EQ(cost, 1);
+    ASSERT_EQ(end, strlen("error: conection"));
+
+    ASSERT_EQ(my_str_approx_find(&str, my_str_view_cstr("refused"), 0, &end, &cost), 0);
+    ASSERT_EQ(end, strlen("error: conection refused"));
+    ASSERT_EQ(cost, 0);
+
+    ASSERT_EQ(my_str_approx_find(&str, my_str_view_cstr("timeout"), 2, &end, &cost), NOT_FOUND_CODE);
+    ASSERT_EQ(my_str_approx_find(&str, my_str_view_cstr(""), 2, &end, &cost), NOT_FOUND_CODE);
+    ASSERT_EQ(my_str_approx_find(nullptr, my_str_view_cstr("a"), 2, &end, &cost), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_approx_find(&str, my_str_view_cstr("a"), 2, nullptr, &cost), NULL_PTR_ERR);
+    my_str_free(&str);
+
+    // non zero value of callback stops the search
+    my_str_approx_t approx;
+    my_str_approx_create(&approx, my_str_view_cstr("ab"));
+    auto stop = [](size_t, size_t, void*) { return 3; };
+    ASSERT_EQ(my_str_approx_search(&approx, my_str_view_cstr("xxabxx"), 0, stop, nullptr), 3);
+    ASSERT_EQ(my_str_approx_search(&approx, my_str_view_cstr("xxabxx"), 0, nullptr, nullptr), NULL_PTR_ERR);
+    my_str_approx_free(&approx);
+}
+
+TEST_F(ApproxDeclaration, my_str_edit_distance) {
+    for (size_t i = 0; i < 300; i++) {
+        std::string a = random_string(gen() % 200, "abc");
+        std::string b = (i % 2) ? mutate(a, gen() % 20) : random_string(gen() % 200, "abc");
+        size_t expected = naive_distance(a, b);
+        my_str_t sa = make_str(a), sb = make_str(b);
+
+        size_t distance = 0;
+        ASSERT_EQ(my_str_edit_distance(&sa, &sb, SIZE_MAX, &distance), 0);
+        ASSERT_EQ(distance, expected) << a << " " << b;
+        ASSERT_EQ(my_str_edit_distance(&sb, &sa, SIZE_MAX, &distance), 0);
+        ASSERT_EQ(distance, expected);
+
+        // with threshold the distance is exact only if it is not greater
+        for (size_t max: {(size_t) 0, (size_t) 5, expected, expected + 1}) {
+            ASSERT_EQ(my_str_edit_distance(&sa, &sb, max, &distance), 0);
+            ASSERT_EQ(distance, std::min(expected, max + 1)) << max;
+            ASSERT_EQ(my_str_edit_distance_banded(&sa, &sb, max, &distance), 0);
+            ASSERT_EQ(distance, std::min(expected, max + 1)) << max;
+        }
+
+        my_str_free(&sa);
+        my_str_free(&sb);
+    }
+
+    my_str_t empty = make_str(""), word = make_str("kitten"), other = make_str("sitting");
+    size_t distance = 0;
+    ASSERT_EQ(my_str_edit_distance(&word, &other, SIZE_MAX, &distance), 0);
+    ASSERT_EQ(distance, 3);
+    ASSERT_EQ(my_str_edit_distance(&empty, &other, SIZE_MAX, &distance), 0);
+    ASSERT_EQ(distance, 7);
+    ASSERT_EQ(my_str_edit_distance_banded(&empty, &empty, 0, &distance), 0);
+    ASSERT_EQ(distance, 0);
+
+    double similarity = 0;
+    ASSERT_EQ(my_str_similarity(&word, &other, &similarity), 0);
+    ASSERT_DOUBLE_EQ(similarity, 1.0 - 3.0 / 7.0);
+    ASSERT_EQ(my_str_similarity(&empty, &empty, &similarity), 0);
+    ASSERT_DOUBLE_EQ(similarity, 1.0);
+
+    ASSERT_EQ(my_str_edit_distance(&word, nullptr, 1, &distance), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_edit_distance_banded(&word, &other, 1, nullptr), NULL_PTR_ERR);
+    my_str_free(&empty);
+    my_str_free(&word);
+    my_str_free(&other);
+}
+
+TEST_F(ApproxDeclaration, my_str_hamming) {
+    for (size_t size: {0, 1, 7, 8, 9, 100}) {
+        std::string a = random_string(size, "ab\xff");
+        std::string b = random_string(size, "ab\xff");
+        size_t expected = 0;
+        for (size_t i = 0; i < size; i++)
+            expected += (a[i] != b[i]);
+
+        my_str_t sa = make_str(a), sb = make_str(b);
+        size_t distance = 0;
+        ASSERT_EQ(my_str_hamming(&sa, &sb, &distance), 0);
+        ASSERT_EQ(distance, expected);
+        my_str_free(&sa);
+        my_str_free(&sb);
+    }
+
+    my_str_t a = make_str("abc"), b = make_str("ab");
+    size_t distance = 0;
+    ASSERT_EQ(my_str_hamming(&a, &b, &distance), RANGE_ERR);
+    ASSERT_EQ(my_str_hamming(&a, &b, nullptr), NULL_PTR_ERR);
+    my_str_free(&a);
+    my_str_free(&b);
+}
+
+TEST_F(ApproxDeclaration, my_str_edit_distance_batch) {
+    std::string query = random_string(100, "acgt");
+    std::vector<std::string> words;
+    std::vector<my_str_t> strs;
+    for (size_t i = 0; i < 1000; i++) {
+        words.push_back(mutate(query, gen() % 30));
+        strs.push_back(make_str(words.back()));
+    }
+    my_str_t q = make_str(query);
+
+    for (size_t threads: {0, 1, 4}) {
+        std::vector<size_t> distances(strs.size());
+        ASSERT_EQ(my_str_edit_distance_batch(&q, strs.data(), strs.size(), 20, distances.data(), threads), 0);
+        for (size_t i = 0; i < strs.size(); i++)
+            ASSERT_EQ(distances[i], std::min<size_t>(naive_distance(query, words[i]), 21)) << i;
+    }
+
+    ASSERT_EQ(my_str_edit_distance_batch(&q, nullptr, 0, 20, nullptr, 0), 0);
+    ASSERT_EQ(my_str_edit_distance_batch(nullptr, strs.data(), 1, 20, nullptr, 0), NULL_PTR_ERR);
+
+    my_str_free(&q);
+    for (auto &str: strs)
+        my_str_free(&str);
+}
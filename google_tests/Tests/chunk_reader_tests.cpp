@@ -0,0 +1,85 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <string>
+#include <memory>
+
+extern "C" {
+#include "c_string_chunk_reader.h"
+#include <unistd.h>
+}
+
+namespace {
+    class ChunkReaderDeclaration : public testing::Test {
+    protected:
+        std::string content;
+        std::unique_ptr<FILE, int (*)(FILE *)> file{nullptr, fclose};
+        my_str_chunk_reader_t reader{};
+
+        void SetUp() override {
+            for (size_t i = 0; i < 10007; i++)
+                content.push_back(static_cast<char>('a' + i % 23));
+            file.reset(tmpfile());
+            ASSERT_TRUE(file);
+            fwrite(content.data(), 1, content.size(), file.get());
+            fflush(file.get());
+            lseek(fileno(file.get()), 0, SEEK_SET);
+        }
+
+        void TearDown() override {
+            my_str_chunk_reader_close(&reader);
+        }
+    };
+}
+
+TEST_F(ChunkReaderDeclaration, my_str_chunk_reader_next) {
+    ASSERT_EQ(my_str_chunk_reader_open(&reader, fileno(file.get()), 1000, 3, 7), 0);
+
+    // chunks cover whole file, every one starts with the tail of previous chunk
+    std::string collected;
+    size_t chunks = 0;
+    my_str_chunk_t chunk;
+    while (my_str_chunk_reader_next(&reader, &chunk) == 0) {
+        ASSERT_EQ(chunk.overlap, chunks ? 7 : 0);
+        ASSERT_EQ(chunk.offset + chunk.overlap, collected.size());
+        ASSERT_EQ(std::string(chunk.view.data, chunk.view.size_m), content.substr(chunk.offset, chunk.view.size_m));
+        collected.append(chunk.view.data + chunk.overlap, chunk.view.size_m - chunk.overlap);
+        chunks++;
+    }
+    ASSERT_EQ(collected, content);
+    ASSERT_EQ(chunks, 11);
+
+    // end is reported again
+    ASSERT_EQ(my_str_chunk_reader_next(&reader, &chunk), NOT_FOUND_CODE);
+}
+
+TEST_F(ChunkReaderDeclaration, my_str_chunk_reader_open) {
+    // pipe that is read in chunks bigger than single writes, no overlap
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(my_str_chunk_reader_open(&reader, fds[0], 8, 0, 0), 0);
+    ASSERT_EQ(write(fds[1], "hello, ", 7), 7);
+    ASSERT_EQ(write(fds[1], "world", 5), 5);
+    close(fds[1]);
+
+    my_str_chunk_t chunk;
+    ASSERT_EQ(my_str_chunk_reader_next(&reader, &chunk), 0);
+    ASSERT_EQ(std::string(chunk.view.data, chunk.view.size_m), "hello, w");
+    ASSERT_EQ(my_str_chunk_reader_next(&reader, &chunk), 0);
+    ASSERT_EQ(std::string(chunk.view.data, chunk.view.size_m), "orld");
+    ASSERT_EQ(chunk.offset, 8);
+    ASSERT_EQ(my_str_chunk_reader_next(&reader, &chunk), NOT_FOUND_CODE);
+    my_str_chunk_reader_close(&reader);
+    close(fds[0]);
+
+    // closing reader that did not hand out everything
+    ASSERT_EQ(my_str_chunk_reader_open(&reader, fileno(file.get()), 16, 2, 0), 0);
+    ASSERT_EQ(my_str_chunk_reader_next(&reader, &chunk), 0);
+    ASSERT_EQ(my_str_chunk_reader_close(&reader), 0);
+
+    // bad arguments
+    ASSERT_EQ(my_str_chunk_reader_open(&reader, -1, 16, 2, 0), IO_READ_ERR);
+    ASSERT_EQ(my_str_chunk_reader_open(nullptr, 0, 16, 2, 0), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_chunk_reader_next(&reader, nullptr), NULL_PTR_ERR);
+}
@@ -0,0 +1,103 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+extern "C" {
+#include "c_string_edit.h"
+}
+
+namespace {
+    class EditDeclaration : public testing::Test {
+    protected:
+        my_str_edits_t edits{};
+        my_str_t str{};
+
+        void SetUp() override {
+            my_str_edits_create(&edits, 0);
+            my_str_create(&str, 0);
+        }
+
+        void TearDown() override {
+            my_str_edits_free(&edits);
+            my_str_free(&str);
+        }
+
+        std::string content() const {
+            return std::string(str.data, str.size_m);
+        }
+    };
+}
+
+TEST_F(EditDeclaration, my_str_edits_commit) {
+    std::mt19937 gen{3};
+    for (size_t round = 0; round < 50; round++) {
+        std::string original;
+        for (size_t i = gen() % 3000; i > 0; i--)
+            original.push_back(static_cast<char>('a' + gen() % 26));
+        my_str_from_cstr(&str, original.c_str(), 0);
+
+        // non overlapping edits in random order
+        std::vector<std::tuple<size_t, size_t, std::string>> queued;
+        for (size_t pos = gen() % 50; pos <= original.size(); pos += gen() % 100) {
+            size_t erase = std::min<size_t>(gen() % 10, original.size() - pos);
+            queued.emplace_back(pos, erase, std::string(gen() % 8, '#'));
+            pos += erase;
+        }
+        std::shuffle(queued.begin(), queued.end(), gen);
+        for (const auto &edit: queued)
+            ASSERT_EQ(my_str_edits_add(&edits, std::get<0>(edit), std::get<1>(edit),
+                                       my_str_view_t{std::get<2>(edit).data(), std::get<2>(edit).size()}), 0);
+        ASSERT_EQ(my_str_edits_size(&edits), queued.size());
+
+        // applied from the end, earlier offsets stay correct
+        std::sort(queued.begin(), queued.end());
+        std::string expected = original;
+        for (auto it = queued.rbegin(); it != queued.rend(); it++)
+            expected.replace(std::get<0>(*it), std::get<1>(*it), std::get<2>(*it));
+
+        ASSERT_EQ(my_str_edits_commit(&edits, &str), 0);
+        ASSERT_EQ(content(), expected);
+        ASSERT_EQ(my_str_edits_size(&edits), 0);
+    }
+}
+
+TEST_F(EditDeclaration, my_str_edits_add) {
+    my_str_from_cstr(&str, "Hello, NAME!", 0);
+
+    // edits at the same position keep order of adding
+    my_str_edits_add(&edits, 12, 0, my_str_view_cstr(" Bye"));
+    my_str_edits_add(&edits, 7, 4, my_str_view_cstr("dear"));
+    my_str_edits_add(&edits, 7, 0, my_str_view_cstr(" friend"));
+    my_str_edits_add(&edits, 12, 0, my_str_view_cstr("!"));
+    my_str_edits_add(&edits, 0, 0, my_str_view_t{nullptr, 0});
+    ASSERT_EQ(my_str_edits_commit(&edits, &str), RANGE_ERR);
+    ASSERT_EQ(content(), "Hello, NAME!");
+
+    // erased range ending at position of the next edit is fine
+    my_str_edits_clear(&edits);
+    my_str_edits_add(&edits, 12, 0, my_str_view_cstr(" Bye"));
+    my_str_edits_add(&edits, 7, 4, my_str_view_cstr("dear"));
+    my_str_edits_add(&edits, 11, 0, my_str_view_cstr(" friend"));
+    my_str_edits_add(&edits, 12, 0, my_str_view_cstr("!"));
+    ASSERT_EQ(my_str_edits_commit(&edits, &str), 0);
+    ASSERT_EQ(content(), "Hello, dear friend! Bye!");
+
+    ASSERT_EQ(my_str_edits_commit(&edits, &str), 0);
+    ASSERT_EQ(content(), "Hello, dear friend! Bye!");
+
+    my_str_edits_add(&edits, 100, 0, my_str_view_cstr("x"));
+    ASSERT_EQ(my_str_edits_commit(&edits, &str), RANGE_ERR);
+    my_str_edits_clear(&edits);
+    my_str_edits_add(&edits, 20, 5, my_str_view_cstr("x"));
+    ASSERT_EQ(my_str_edits_commit(&edits, &str), RANGE_ERR);
+
+    ASSERT_EQ(my_str_edits_add(&edits, 0, 0, my_str_view_t{nullptr, 1}), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_edits_add(nullptr, 0, 0, my_str_view_cstr("x")), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_edits_commit(&edits, nullptr), NULL_PTR_ERR);
+}
@@ -0,0 +1,110 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+extern "C" {
+#include "c_string_gap.h"
+}
+
+namespace {
+    class GapDeclaration : public testing::Test {
+    protected:
+        my_str_gap_t gap{};
+
+        void SetUp() override {
+            my_str_gap_create(&gap, 4);
+        }
+
+        void TearDown() override {
+            my_str_gap_free(&gap);
+        }
+
+        std::string content() {
+            my_str_view_t view{};
+            EXPECT_EQ(my_str_gap_view(&gap, &view), 0);
+            return std::string(view.data, view.size_m);
+        }
+    };
+}
+
+TEST_F(GapDeclaration, my_str_gap_insert) {
+    // typing at the cursor, then jumping to other places
+    std::mt19937 gen{11};
+    std::string expected;
+    size_t cursor = 0;
+    for (size_t i = 0; i < 20000; i++) {
+        if (i % 100 == 0)
+            cursor = gen() % (expected.size() + 1);
+        char c = static_cast<char>('a' + gen() % 26);
+        ASSERT_EQ(my_str_gap_insert_c(&gap, c, cursor), 0);
+        expected.insert(cursor, 1, c);
+        cursor++;
+        ASSERT_EQ(my_str_gap_cursor(&gap), cursor);
+    }
+    ASSERT_EQ(my_str_gap_size(&gap), expected.size());
+
+    char c = 0;
+    for (size_t i = 0; i < expected.size(); i += 101) {
+        ASSERT_EQ(my_str_gap_getc(&gap, i, &c), 0);
+        ASSERT_EQ(c, expected[i]);
+    }
+    ASSERT_EQ(my_str_gap_getc(&gap, expected.size(), &c), RANGE_ERR);
+
+    ASSERT_EQ(my_str_gap_insert(&gap, my_str_view_cstr("<word>"), 10), 0);
+    expected.insert(10, "<word>");
+    ASSERT_EQ(my_str_gap_cursor(&gap), 16);
+    ASSERT_EQ(content(), expected);
+    ASSERT_EQ(my_str_gap_cursor(&gap), expected.size());
+
+    ASSERT_EQ(my_str_gap_insert_c(&gap, 'a', expected.size() + 1), RANGE_ERR);
+    ASSERT_EQ(my_str_gap_insert(nullptr, my_str_view_cstr("a"), 0), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_gap_move(&gap, expected.size() + 1), RANGE_ERR);
+}
+
+TEST_F(GapDeclaration, my_str_gap_erase) {
+    my_str_gap_insert(&gap, my_str_view_cstr("hello, world"), 0);
+
+    // backspace and delete around the cursor
+    ASSERT_EQ(my_str_gap_move(&gap, 5), 0);
+    ASSERT_EQ(my_str_gap_erase(&gap, 3, 5), 0);
+    ASSERT_EQ(my_str_gap_cursor(&gap), 3);
+    ASSERT_EQ(my_str_gap_erase(&gap, 3, 4), 0);
+    ASSERT_EQ(my_str_gap_insert_c(&gap, ';', 3), 0);
+    ASSERT_EQ(content(), "hel; world");
+
+    ASSERT_EQ(my_str_gap_erase(&gap, 4, 100), 0);
+    ASSERT_EQ(content(), "hel;");
+    ASSERT_EQ(my_str_gap_erase(&gap, 0, 4), 0);
+    ASSERT_EQ(my_str_gap_size(&gap), 0);
+
+    ASSERT_EQ(my_str_gap_erase(&gap, 1, 2), RANGE_ERR);
+    my_str_gap_insert(&gap, my_str_view_cstr("abc"), 0);
+    ASSERT_EQ(my_str_gap_erase(&gap, 2, 1), RANGE_ERR);
+    ASSERT_EQ(my_str_gap_erase(nullptr, 0, 1), NULL_PTR_ERR);
+}
+
+TEST_F(GapDeclaration, my_str_gap_to_str) {
+    my_str_gap_insert(&gap, my_str_view_cstr("left right"), 0);
+    my_str_gap_move(&gap, 4);
+
+    my_str_t str;
+    my_str_create(&str, 0);
+    my_str_from_cstr(&str, "old content that is longer", 0);
+    ASSERT_EQ(my_str_gap_to_str(&gap, &str), 0);
+    ASSERT_EQ(std::string(str.data, str.size_m), "left right");
+    // gap buffer is not changed
+    ASSERT_EQ(my_str_gap_cursor(&gap), 4);
+
+    ASSERT_EQ(my_str_gap_to_str(&gap, nullptr), NULL_PTR_ERR);
+    my_str_free(&str);
+
+    my_str_gap_t empty;
+    ASSERT_EQ(my_str_gap_create(&empty, 0), 0);
+    ASSERT_EQ(my_str_gap_insert(&empty, my_str_view_cstr("grows"), 0), 0);
+    ASSERT_EQ(my_str_gap_size(&empty), 5);
+    my_str_gap_free(&empty);
+    ASSERT_EQ(my_str_gap_create(nullptr, 0), NULL_PTR_ERR);
+}
@@ -0,0 +1,223 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "c_string_index.h"
+}
+
+namespace {
+    class IndexDeclaration : public testing::Test {
+    protected:
+        my_str_t text{};
+        std::string source;
+        my_str_index_t index{};
+
+        void SetUp() override {
+            my_str_create(&text, 0);
+        }
+
+        void TearDown() override {
+            my_str_index_free(&index);
+            my_str_free(&text);
+        }
+
+        // small alphabet gives long repeats, so SA-IS recursion is used
+        void make_text(size_t size, const char* alphabet, unsigned seed) {
+            std::mt19937 gen{seed};
+            size_t letters = strlen(alphabet);
+            source.clear();
+            for (size_t i = 0; i < size; i++)
+                source.push_back(alphabet[gen() % letters]);
+            set_text(source);
+        }
+
+        void set_text(const std::string &str) {
+            source = str;
+            my_str_reserve(&text, str.size());
+            if (!str.empty())
+                memcpy(text.data, str.data(), str.size());
+            text.size_m = str.size();
+        }
+
+        std::vector<size_t> naive(const std::string &pattern) const {
+            std::vector<size_t> positions;
+            if (pattern.empty())
+                return positions;
+            for (size_t pos = source.find(pattern); pos != std::string::npos; pos = source.find(pattern, pos + 1))
+                positions.push_back(pos);
+            return positions;
+        }
+
+        void check(const std::string &pattern) {
+            std::vector<size_t> expected = naive(pattern);
+            my_str_view_t view{pattern.data(), pattern.size()};
+
+            size_t count = 0;
+            ASSERT_EQ(my_str_index_count(&index, view, &count), 0);
+            ASSERT_EQ(count, expected.size()) << pattern;
+
+            size_t pos = 0;
+            if (expected.empty()) {
+                ASSERT_EQ(my_str_index_find(&index, view, &pos), NOT_FOUND_CODE) << pattern;
+            } else {
+                ASSERT_EQ(my_str_index_find(&index, view, &pos), 0);
+                ASSERT_EQ(pos, expected[0]) << pattern;
+            }
+
+            std::vector<size_t> positions(expected.size());
+            ASSERT_EQ(my_str_index_locate(&index, view, positions.data(), positions.size(), &count), 0);
+            ASSERT_EQ(positions, expected) << pattern;
+        }
+
+        void check_all(unsigned seed) {
+            std::mt19937 gen{seed};
+            for (size_t i = 0; i < 200 && !source.empty(); i++) {
+                size_t start = gen() % source.size();
+                check(source.substr(start, 1 + gen() % 12));
+            }
+            for (const char* pattern: {"", "a", "ab", "abcabc", "zzz", "\xff", "c\xff"})
+                check(pattern);
+            check(source);
+            check(source + "a");
+        }
+    };
+}
+
+TEST_F(IndexDeclaration, my_str_index_build) {
+    for (int flags: {0, MY_STR_INDEX_FM}) {
+        for (size_t size: {0, 1, 2, 3, 64, 127, 128, 129, 1000, 10000}) {
+            for (const char* alphabet: {"a", "ab", "abc\xff", "the quick brown fox jumps over lazy dog"}) {
+                make_text(size, alphabet, (unsigned) size);
+                ASSERT_EQ(my_str_index_build(&index, &text, flags), 0);
+                check_all((unsigned) size + 1);
+                my_str_index_free(&index);
+            }
+        }
+    }
+
+    set_text("mississippi");
+    ASSERT_EQ(my_str_index_build(&index, &text, 0), 0);
+    std::vector<size_t> expected{11, 10, 7, 4, 1, 0, 9, 8, 6, 3, 5, 2};
+    ASSERT_EQ(std::vector<size_t>(index.sa, index.sa + 12), expected);
+
+    ASSERT_EQ(my_str_index_build(nullptr, &text, 0), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_index_build(&index, nullptr, 0), NULL_PTR_ERR);
+}
+
+TEST_F(IndexDeclaration, my_str_index_locate) {
+    make_text(10000, "ab", 3);
+    ASSERT_EQ(my_str_index_build(&index, &text, MY_STR_INDEX_FM), 0);
+
+    // only some of occurrences fit, but all of them are counted
+    size_t count = 0;
+    std::vector<size_t> positions(5);
+    ASSERT_EQ(my_str_index_locate(&index, my_str_view_cstr("ab"), positions.data(), positions.size(), &count), 0);
+    ASSERT_EQ(count, naive("ab").size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        ASSERT_EQ(source.compare(positions[i], 2, "ab"), 0);
+        if (i) {
+            ASSERT_LT(positions[i - 1], positions[i]);
+        }
+    }
+
+    ASSERT_EQ(my_str_index_locate(&index, my_str_view_cstr("ab"), nullptr, 0, &count), 0);
+    ASSERT_EQ(my_str_index_locate(&index, my_str_view_cstr("ab"), nullptr, 1, &count), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_index_count(&index, my_str_view_cstr("ab"), nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_index_find(nullptr, my_str_view_cstr("ab"), &count), NULL_PTR_ERR);
+}
+
+TEST_F(IndexDeclaration, my_str_index_memory) {
+    make_text(100000, "the quick brown fox jumps over lazy dog", 5);
+    ASSERT_EQ(my_str_index_build(&index, &text, 0), 0);
+    size_t sa_memory = my_str_index_memory(&index);
+    my_str_index_free(&index);
+
+    ASSERT_EQ(my_str_index_build(&index, &text, MY_STR_INDEX_FM), 0);
+    size_t fm_memory = my_str_index_memory(&index);
+    ASSERT_GE(sa_memory, source.size() * (sizeof(size_t) + 1));
+    ASSERT_LT(fm_memory, source.size() * 3);
+    ASSERT_EQ(my_str_index_memory(nullptr), 0);
+}
+
+TEST_F(IndexDeclaration, my_str_index_save) {
+    for (int flags: {0, MY_STR_INDEX_FM}) {
+        make_text(20000, "abc", 9);
+        ASSERT_EQ(my_str_index_build(&index, &text, flags), 0);
+
+        FILE* file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(my_str_index_save(&index, file), 0);
+        my_str_index_free(&index);
+
+        rewind(file);
+        ASSERT_EQ(my_str_index_load(&index, file), 0);
+        ASSERT_EQ(index.flags, flags);
+        check_all(11);
+        my_str_index_free(&index);
+
+        // truncated and foreign files are not loaded
+        rewind(file);
+        fputs("not an index", file);
+        rewind(file);
+        ASSERT_EQ(my_str_index_load(&index, file), IO_READ_ERR);
+        fclose(file);
+
+        file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(my_str_index_load(&index, file), IO_READ_ERR);
+        fclose(file);
+    }
+
+    ASSERT_EQ(my_str_index_save(&index, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_index_load(nullptr, nullptr), NULL_PTR_ERR);
+}
+
+TEST_F(IndexDeclaration, my_str_index_load_marks) {
+    make_text(5000, "acgt", 4);
+    ASSERT_EQ(my_str_index_build(&index, &text, MY_STR_INDEX_FM), 0);
+    size_t primary = index.primary, rows = index.size_m + 1;
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(my_str_index_save(&index, file), 0);
+    my_str_index_free(&index);
+
+    // marks are followed by samples at the end of the file
+    std::vector<char> saved(static_cast<size_t>(ftell(file)));
+    rewind(file);
+    ASSERT_EQ(fread(saved.data(), 1, saved.size(), file), saved.size());
+    fclose(file);
+    size_t marks = saved.size() - ((rows - 1) / MY_STR_INDEX_SAMPLE_STEP + 1) * sizeof(uint32_t) -
+                   (rows / 64 + 1) * sizeof(uint64_t);
+
+    // locate would never stop without the mark of primary row or with missing marks
+    for (size_t bit: {primary, (primary + 1) % rows, rows}) {
+        std::vector<char> broken = saved;
+        broken[marks + bit / 8] ^= static_cast<char>(1 << (bit % 8));
+        file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        fwrite(broken.data(), 1, broken.size(), file);
+        rewind(file);
+        ASSERT_EQ(my_str_index_load(&index, file), IO_READ_ERR) << bit;
+        fclose(file);
+    }
+
+    // changed transform splits rows into several cycles, some of them without marks
+    size_t bwt = marks - rows;
+    for (size_t row: {size_t{1}, rows / 2, rows - 1}) {
+        if (row == primary)
+            continue;
+        std::vector<char> broken = saved;
+        broken[bwt + row] = static_cast<char>(broken[bwt + row] == 'a' ? 'c' : 'a');
+        file = tmpfile();
+        ASSERT_NE(file, nullptr);
+        fwrite(broken.data(), 1, broken.size(), file);
+        rewind(file);
+        ASSERT_EQ(my_str_index_load(&index, file), IO_READ_ERR) << row;
+        fclose(file);
+    }
+}
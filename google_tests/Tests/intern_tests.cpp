@@ -0,0 +1,131 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "c_string_intern.h"
+}
+
+namespace {
+    class InternDeclaration : public testing::Test {
+    protected:
+        my_str_intern_t table{};
+        my_str_intern_t concurrent_table{};
+
+        void SetUp() override {
+            my_str_intern_create(&table, 0);
+            my_str_intern_create(&concurrent_table, 1);
+        }
+
+        void TearDown() override {
+            my_str_intern_free(&table);
+            my_str_intern_free(&concurrent_table);
+        }
+    };
+
+    my_str_view_t view_of(const std::string &str) {
+        return my_str_view_t{str.data(), str.size()};
+    }
+}
+
+TEST_F(InternDeclaration, my_str_intern) {
+    std::string first = "hello";
+    std::string second = "hello";
+    my_str_view_t canonical1, canonical2;
+    size_t id1, id2;
+
+    // equal content gives the same canonical pointer and id
+    ASSERT_EQ(my_str_intern(&table, view_of(first), &canonical1, &id1), 0);
+    ASSERT_EQ(my_str_intern(&table, view_of(second), &canonical2, &id2), 1);
+    ASSERT_EQ(canonical1.data, canonical2.data);
+    ASSERT_EQ(id1, id2);
+    ASSERT_NE(canonical1.data, first.data());
+    ASSERT_STREQ(canonical1.data, "hello");
+
+    // different content, empty string
+    ASSERT_EQ(my_str_intern(&table, my_str_view_cstr("world"), &canonical2, &id2), 0);
+    ASSERT_NE(canonical1.data, canonical2.data);
+    ASSERT_NE(id1, id2);
+    ASSERT_EQ(my_str_intern(&table, my_str_view_cstr(""), &canonical2, nullptr), 0);
+    ASSERT_EQ(canonical2.size_m, 0);
+
+    // canonical copies do not move while table grows
+    for (size_t i = 0; i < 100000; i++)
+        ASSERT_GE(my_str_intern(&table, view_of(std::to_string(i % 50000)), nullptr, nullptr), 0);
+    ASSERT_EQ(my_str_intern_count(&table), 50003);
+    ASSERT_EQ(my_str_intern(&table, my_str_view_cstr("hello"), &canonical2, &id2), 1);
+    ASSERT_EQ(canonical1.data, canonical2.data);
+    ASSERT_EQ(id1, id2);
+
+    // bad arguments
+    ASSERT_EQ(my_str_intern(nullptr, my_str_view_cstr("a"), nullptr, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_intern(&table, my_str_view_t{nullptr, 2}, nullptr, nullptr), NULL_PTR_ERR);
+}
+
+TEST_F(InternDeclaration, my_str_intern_find) {
+    size_t id;
+    my_str_view_t canonical;
+    ASSERT_EQ(my_str_intern_find(&table, my_str_view_cstr("hello"), &canonical, &id), NOT_FOUND_CODE);
+    ASSERT_EQ(my_str_intern_count(&table), 0);
+
+    ASSERT_EQ(my_str_intern(&table, my_str_view_cstr("hello"), nullptr, &id), 0);
+    ASSERT_EQ(my_str_intern_find(&table, my_str_view_cstr("hello"), &canonical, nullptr), 0);
+    ASSERT_STREQ(canonical.data, "hello");
+
+    // by id
+    ASSERT_EQ(my_str_intern_get(&table, id, &canonical), 0);
+    ASSERT_STREQ(canonical.data, "hello");
+    ASSERT_EQ(my_str_intern_get(&table, id + 1, &canonical), RANGE_ERR);
+
+    ASSERT_EQ(my_str_intern_find(nullptr, my_str_view_cstr("hello"), nullptr, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_intern_get(&table, id, nullptr), NULL_PTR_ERR);
+}
+
+TEST_F(InternDeclaration, my_str_intern_concurrent) {
+    constexpr size_t threads_count = 4, distinct = 5000;
+    std::vector<std::vector<size_t>> ids(threads_count, std::vector<size_t>(distinct));
+
+    // every thread interns the same strings in a different order (strides are coprime with distinct)
+    const size_t strides[threads_count] = {1, 3, 7, 9};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threads_count; t++) {
+        threads.emplace_back([this, t, &ids, &strides]() {
+            for (size_t i = 0; i < distinct; i++) {
+                size_t key = (i * strides[t]) % distinct;
+                my_str_intern(&concurrent_table, view_of("key" + std::to_string(key)), nullptr, &ids[t][key]);
+            }
+        });
+    }
+    for (auto &thread: threads)
+        thread.join();
+
+    ASSERT_EQ(my_str_intern_count(&concurrent_table), distinct);
+    for (size_t t = 1; t < threads_count; t++)
+        ASSERT_EQ(ids[t], ids[0]);
+
+    my_str_view_t canonical;
+    ASSERT_EQ(my_str_intern_get(&concurrent_table, ids[0][42], &canonical), 0);
+    ASSERT_STREQ(canonical.data, "key42");
+}
+
+TEST_F(InternDeclaration, my_str_intern_memory) {
+    size_t empty = my_str_intern_memory(&table);
+    ASSERT_GT(empty, 0);
+
+    // bytes of strings are accounted in blocks
+    ASSERT_EQ(my_str_intern(&table, my_str_view_cstr("hello"), nullptr, nullptr), 0);
+    ASSERT_GE(my_str_intern_memory(&table), empty + MY_STR_INTERN_BLOCK);
+
+    // string bigger than a block gets its own one
+    std::string big(MY_STR_INTERN_BLOCK * 2, 'a');
+    size_t before = my_str_intern_memory(&table);
+    ASSERT_EQ(my_str_intern(&table, view_of(big), nullptr, nullptr), 0);
+    ASSERT_GE(my_str_intern_memory(&table), before + big.size() + 1);
+
+    ASSERT_EQ(my_str_intern_memory(nullptr), 0);
+    ASSERT_EQ(my_str_intern_count(nullptr), 0);
+}
@@ -0,0 +1,110 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "c_string_keywords.hpp"
+
+#define HTTP_METHODS(X) X(HTTP_GET, "GET") X(HTTP_HEAD, "HEAD") X(HTTP_POST, "POST") X(HTTP_PUT, "PUT") \
+    X(HTTP_DELETE, "DELETE") X(HTTP_CONNECT, "CONNECT") X(HTTP_OPTIONS, "OPTIONS") X(HTTP_TRACE, "TRACE") \
+    X(HTTP_PATCH, "PATCH") X(HTTP_EMPTY, "")
+
+namespace {
+    enum { HTTP_METHODS(MY_STR_KW_ID) HTTP_METHODS_COUNT };
+    constexpr const char* http_methods[] = { HTTP_METHODS(MY_STR_KW_TEXT) };
+    constexpr auto http_table = my_str::make_keyword_table(http_methods);
+
+    static_assert(http_table.id_of("PATCH") == HTTP_PATCH, "compile time lookup");
+    static_assert(http_table.id_of("PATC") == NOT_FOUND_CODE, "compile time lookup");
+
+    class KeywordsDeclaration : public testing::Test {
+    protected:
+        my_str_kw_table_t table{};
+        std::vector<std::string> words;
+        std::vector<const char*> cstrs;
+
+        void TearDown() override {
+            my_str_kw_free(&table);
+        }
+
+        void make_words(size_t count) {
+            words.clear();
+            cstrs.clear();
+            for (size_t i = 0; i < count; i++)
+                words.push_back("kw_" + std::to_string(i * 7919));
+            for (auto &word: words)
+                cstrs.push_back(word.c_str());
+        }
+    };
+}
+
+TEST_F(KeywordsDeclaration, my_str_kw_match) {
+    for (size_t count: {1, 2, 3, 50, 1000, 20000}) {
+        make_words(count);
+        ASSERT_EQ(my_str_kw_create(&table, cstrs.data(), cstrs.size()), 0);
+
+        for (size_t i = 0; i < count; i++)
+            ASSERT_EQ(my_str_kw_match(&table, my_str_view_cstr(cstrs[i])), (int) i);
+
+        // prefixes, extensions and other strings are not keywords
+        ASSERT_EQ(my_str_kw_match(&table, my_str_view_cstr("kw_")), NOT_FOUND_CODE);
+        ASSERT_EQ(my_str_kw_match(&table, my_str_view_cstr("kw_00")), NOT_FOUND_CODE);
+        ASSERT_EQ(my_str_kw_match(&table, my_str_view_t{cstrs[0], words[0].size() - 1}), NOT_FOUND_CODE);
+        std::string longer = words[0] + "x";
+        ASSERT_EQ(my_str_kw_match(&table, my_str_view_t{longer.data(), longer.size()}), NOT_FOUND_CODE);
+        ASSERT_EQ(my_str_kw_match(&table, my_str_view_cstr("")), NOT_FOUND_CODE);
+
+        my_str_kw_free(&table);
+    }
+
+    my_str_t str;
+    my_str_create(&str, 0);
+    my_str_from_cstr(&str, "DELETE", 0);
+    ASSERT_EQ(my_str_kw_create(&table, http_methods, HTTP_METHODS_COUNT), 0);
+    ASSERT_EQ(my_str_kw_match_str(&table, &str), HTTP_DELETE);
+    ASSERT_EQ(my_str_kw_match(&table, my_str_view_cstr("")), HTTP_EMPTY);
+    ASSERT_EQ(my_str_kw_match_str(&table, nullptr), NULL_PTR_ERR);
+    my_str_free(&str);
+    my_str_kw_free(&table);
+
+    ASSERT_EQ(my_str_kw_match(nullptr, my_str_view_cstr("GET")), NULL_PTR_ERR);
+}
+
+TEST_F(KeywordsDeclaration, my_str_kw_create) {
+    const char* repeated[] = {"a", "b", "a"};
+    ASSERT_EQ(my_str_kw_create(&table, repeated, 3), RANGE_ERR);
+    ASSERT_EQ(table.memory, nullptr);
+
+    const char* with_null[] = {"a", nullptr};
+    ASSERT_EQ(my_str_kw_create(&table, with_null, 2), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_kw_create(nullptr, http_methods, 1), NULL_PTR_ERR);
+
+    ASSERT_EQ(my_str_kw_create(&table, nullptr, 0), 0);
+    ASSERT_EQ(my_str_kw_match(&table, my_str_view_cstr("GET")), NOT_FOUND_CODE);
+}
+
+TEST_F(KeywordsDeclaration, keyword_table) {
+    for (size_t i = 0; i < HTTP_METHODS_COUNT; i++)
+        ASSERT_EQ(http_table.match(my_str_view_cstr(http_methods[i])), (int) i);
+    ASSERT_EQ(http_table.match(my_str_view_cstr("get")), NOT_FOUND_CODE);
+
+    // the table built in compile time is the same as the one built by C function
+    ASSERT_EQ(my_str_kw_create(&table, http_methods, HTTP_METHODS_COUNT), 0);
+    my_str_kw_table_t compiled = http_table.table();
+    ASSERT_EQ(compiled.capacity, table.capacity);
+    ASSERT_EQ(compiled.buckets, table.buckets);
+    for (size_t i = 0; i < table.capacity; i++)
+        ASSERT_EQ(compiled.slots[i], table.slots[i]);
+    for (size_t i = 0; i < table.buckets; i++)
+        ASSERT_EQ(compiled.displacements[i], table.displacements[i]);
+
+    const char* token = "OPTIONS";
+    switch (http_table.match(my_str_view_cstr(token))) {
+        case http_table.id_of("OPTIONS"):
+            break;
+        default:
+            FAIL() << "OPTIONS was not matched";
+    }
+}
@@ -0,0 +1,77 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <fstream>
+
+extern "C" {
+#include "c_string_loader.h"
+}
+
+namespace {
+    class LoaderDeclaration : public testing::Test {
+    protected:
+        static constexpr size_t files_count = 16;
+
+        std::vector<std::string> paths;
+        std::vector<std::string> contents;
+        std::vector<const char *> c_paths;
+        my_str_t strs[files_count]{};
+
+        void SetUp() override {
+            for (size_t i = 0; i < files_count; i++) {
+                paths.push_back(testing::TempDir() + "c_string_loader_" + std::to_string(i) + ".txt");
+                // sizes differ a lot, the first file is empty
+                contents.emplace_back(i * i * 97, static_cast<char>('a' + i));
+                std::ofstream out{paths.back(), std::ios::trunc | std::ios::binary};
+                out << contents.back();
+                my_str_create(&strs[i], 0);
+            }
+            for (auto &path: paths)
+                c_paths.push_back(path.c_str());
+        }
+
+        void TearDown() override {
+            for (size_t i = 0; i < files_count; i++) {
+                std::remove(paths[i].c_str());
+                my_str_free(&strs[i]);
+            }
+        }
+    };
+}
+
+TEST_F(LoaderDeclaration, my_str_read_files) {
+    int errors[files_count];
+
+    // several workers, no memory bound
+    ASSERT_EQ(my_str_read_files(strs, c_paths.data(), files_count, 4, 0, errors), 0);
+    for (size_t i = 0; i < files_count; i++) {
+        ASSERT_EQ(errors[i], 0);
+        ASSERT_EQ(std::string(strs[i].data, strs[i].size_m), contents[i]);
+    }
+
+    // memory bound is smaller than the biggest file, default number of workers
+    for (auto &str: strs)
+        my_str_clear(&str);
+    ASSERT_EQ(my_str_read_files(strs, c_paths.data(), files_count, 0, 1000, nullptr), 0);
+    for (size_t i = 0; i < files_count; i++)
+        ASSERT_EQ(std::string(strs[i].data, strs[i].size_m), contents[i]);
+
+    // per file errors
+    std::string missing = testing::TempDir() + "c_string_loader_missing.txt";
+    const char *bad_paths[3] = {c_paths[3], missing.c_str(), nullptr};
+    ASSERT_EQ(my_str_read_files(strs, bad_paths, 3, 2, 0, errors), IO_READ_ERR);
+    ASSERT_EQ(errors[0], 0);
+    ASSERT_EQ(errors[1], IO_READ_ERR);
+    ASSERT_EQ(errors[2], NULL_PTR_ERR);
+    ASSERT_EQ(std::string(strs[0].data, strs[0].size_m), contents[3]);
+
+    // nothing to load
+    ASSERT_EQ(my_str_read_files(strs, c_paths.data(), 0, 4, 0, errors), 0);
+
+    // one of arguments is NULL
+    ASSERT_EQ(my_str_read_files(nullptr, c_paths.data(), files_count, 4, 0, errors), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_read_files(strs, nullptr, files_count, 4, 0, errors), NULL_PTR_ERR);
+}
@@ -0,0 +1,143 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <string>
+#include <map>
+#include <random>
+
+extern "C" {
+#include "c_string_map.h"
+}
+
+namespace {
+    class MapDeclaration : public testing::Test {
+    protected:
+        my_str_map_t map{};
+
+        void SetUp() override {
+            my_str_map_create(&map, 0);
+        }
+
+        void TearDown() override {
+            my_str_map_free(&map);
+        }
+    };
+
+    my_str_view_t view_of(const std::string &str) {
+        return my_str_view_t{str.data(), str.size()};
+    }
+
+    void *to_value(size_t value) {
+        return reinterpret_cast<void *>(value);
+    }
+}
+
+TEST_F(MapDeclaration, my_str_map_insert) {
+    // new keys and replaced values
+    ASSERT_EQ(my_str_map_insert(&map, my_str_view_cstr("hello"), to_value(1)), 0);
+    ASSERT_EQ(my_str_map_insert(&map, my_str_view_cstr("world"), to_value(2)), 0);
+    ASSERT_EQ(my_str_map_insert(&map, my_str_view_cstr("hello"), to_value(3)), 1);
+    ASSERT_EQ(my_str_map_insert(&map, my_str_view_cstr(""), to_value(4)), 0);
+    ASSERT_EQ(my_str_map_size(&map), 3);
+
+    void *value = nullptr;
+    ASSERT_EQ(my_str_map_find(&map, my_str_view_cstr("hello"), &value), 0);
+    ASSERT_EQ(value, to_value(3));
+    ASSERT_EQ(my_str_map_find(&map, my_str_view_cstr(""), &value), 0);
+    ASSERT_EQ(value, to_value(4));
+    ASSERT_EQ(my_str_map_find(&map, my_str_view_cstr("hell"), &value), NOT_FOUND_CODE);
+
+    // key is copied, so the source may change
+    std::string key = "temporary";
+    ASSERT_EQ(my_str_map_insert(&map, view_of(key), nullptr), 0);
+    key[0] = 'T';
+    ASSERT_EQ(my_str_map_find(&map, my_str_view_cstr("temporary"), nullptr), 0);
+    ASSERT_EQ(my_str_map_find(&map, view_of(key), nullptr), NOT_FOUND_CODE);
+
+    // bad arguments
+    ASSERT_EQ(my_str_map_insert(nullptr, my_str_view_cstr("a"), nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_map_insert(&map, my_str_view_t{nullptr, 3}, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_map_find(nullptr, my_str_view_cstr("a"), nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_map_create(nullptr, 0), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_map_size(nullptr), 0);
+}
+
+TEST_F(MapDeclaration, my_str_map_find_str) {
+    my_str_t key{};
+    my_str_create(&key, 0);
+    my_str_from_cstr(&key, "hello", 0);
+    ASSERT_EQ(my_str_map_insert(&map, my_str_view(&key), to_value(7)), 0);
+
+    // with and without remembered hash
+    void *value = nullptr;
+    ASSERT_EQ(my_str_map_find_str(&map, &key, &value), 0);
+    ASSERT_EQ(value, to_value(7));
+    my_str_hash_cached(&key);
+    ASSERT_EQ(my_str_map_find_str(&map, &key, &value), 0);
+    my_str_append_c(&key, '!');
+    ASSERT_EQ(my_str_map_find_str(&map, &key, &value), NOT_FOUND_CODE);
+
+    ASSERT_EQ(my_str_map_find_str(&map, nullptr, &value), NULL_PTR_ERR);
+    my_str_free(&key);
+}
+
+TEST_F(MapDeclaration, my_str_map_erase) {
+    std::map<std::string, size_t> expected;
+    std::mt19937 gen{42};
+
+    // random mix of operations with many collisions of short keys
+    for (size_t i = 0; i < 20000; i++) {
+        std::string key = std::to_string(gen() % 3000);
+        switch (gen() % 3) {
+            case 0:
+            case 1:
+                ASSERT_EQ(my_str_map_insert(&map, view_of(key), to_value(i)), expected.count(key) ? 1 : 0);
+                expected[key] = i;
+                break;
+            default:
+                ASSERT_EQ(my_str_map_erase(&map, view_of(key)), expected.erase(key) ? 0 : NOT_FOUND_CODE);
+        }
+        ASSERT_EQ(my_str_map_size(&map), expected.size());
+    }
+
+    for (size_t i = 0; i < 3000; i++) {
+        std::string key = std::to_string(i);
+        void *value = nullptr;
+        auto it = expected.find(key);
+        ASSERT_EQ(my_str_map_find(&map, view_of(key), &value), it == expected.end() ? NOT_FOUND_CODE : 0);
+        if (it != expected.end()) {
+            ASSERT_EQ(value, to_value(it->second));
+        }
+    }
+
+    // iteration visits every key once
+    size_t iter = 0, visited = 0;
+    my_str_view_t key;
+    void *value;
+    while (my_str_map_next(&map, &iter, &key, &value) == 0) {
+        ASSERT_EQ(expected.at(std::string(key.data, key.size_m)), reinterpret_cast<size_t>(value));
+        visited++;
+    }
+    ASSERT_EQ(visited, expected.size());
+
+    ASSERT_EQ(my_str_map_erase(nullptr, my_str_view_cstr("1")), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_map_next(&map, nullptr, &key, &value), NULL_PTR_ERR);
+}
+
+TEST_F(MapDeclaration, my_str_map_reserve) {
+    ASSERT_EQ(my_str_map_reserve(&map, 1000), 0);
+    size_t capacity = map.capacity;
+    ASSERT_GE(capacity / 8 * 7, 1000);
+
+    // no rehash while inserting reserved number of keys
+    for (size_t i = 0; i < 1000; i++)
+        ASSERT_EQ(my_str_map_insert(&map, view_of(std::to_string(i)), nullptr), 0);
+    ASSERT_EQ(map.capacity, capacity);
+
+    // smaller reserve does nothing
+    ASSERT_EQ(my_str_map_reserve(&map, 10), 0);
+    ASSERT_EQ(map.capacity, capacity);
+
+    ASSERT_EQ(my_str_map_reserve(nullptr, 10), NULL_PTR_ERR);
+}
@@ -0,0 +1,163 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "c_string_piece.h"
+}
+
+namespace {
+    class PieceDeclaration : public testing::Test {
+    protected:
+        std::string original = "The quick brown fox jumps over the lazy dog";
+        my_str_piece_table_t table{};
+        std::mt19937 gen{9};
+
+        void SetUp() override {
+            my_str_piece_create(&table, my_str_view_t{original.data(), original.size()});
+        }
+
+        void TearDown() override {
+            my_str_piece_free(&table);
+        }
+
+        static int append_chunk(const char* chunk, size_t size, void* arg) {
+            static_cast<std::string *>(arg)->append(chunk, size);
+            return 0;
+        }
+
+        static int count_chunk(const char*, size_t, void* arg) {
+            ++*static_cast<size_t *>(arg);
+            return 0;
+        }
+
+        std::string content(size_t pos = 0, size_t size = SIZE_MAX) {
+            std::string result;
+            EXPECT_EQ(my_str_piece_for_each(&table, pos, size, append_chunk, &result), 0);
+            return result;
+        }
+
+        size_t pieces() {
+            size_t count = 0;
+            my_str_piece_for_each(&table, 0, SIZE_MAX, count_chunk, &count);
+            return count;
+        }
+
+        // random insert or erase applied to both table and expected
+        void random_edit(std::string &expected) {
+            size_t pos = gen() % (expected.size() + 1);
+            if (gen() % 3) {
+                std::string data(gen() % 10 + 1, static_cast<char>('a' + gen() % 26));
+                ASSERT_EQ(my_str_piece_insert(&table, pos, my_str_view_t{data.data(), data.size()}), 0);
+                expected.insert(pos, data);
+            } else {
+                size_t size = gen() % 20;
+                ASSERT_EQ(my_str_piece_erase(&table, pos, size), 0);
+                expected.erase(pos, size);
+            }
+        }
+    };
+}
+
+TEST_F(PieceDeclaration, my_str_piece_insert) {
+    std::string expected = original;
+    for (size_t i = 0; i < 5000; i++) {
+        random_edit(expected);
+        ASSERT_EQ(my_str_piece_size(&table), expected.size());
+    }
+    ASSERT_EQ(content(), expected);
+    ASSERT_EQ(content(10, 100), expected.substr(10, 100));
+
+    // original buffer is never changed
+    ASSERT_EQ(original, "The quick brown fox jumps over the lazy dog");
+
+    ASSERT_EQ(my_str_piece_insert(&table, expected.size() + 1, my_str_view_cstr("x")), RANGE_ERR);
+    ASSERT_EQ(my_str_piece_erase(&table, expected.size() + 1, 1), RANGE_ERR);
+    ASSERT_EQ(my_str_piece_insert(nullptr, 0, my_str_view_cstr("x")), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_piece_insert(&table, 0, my_str_view_t{nullptr, 1}), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_piece_for_each(&table, 0, 1, nullptr, nullptr), NULL_PTR_ERR);
+}
+
+TEST_F(PieceDeclaration, my_str_piece_append) {
+    // typing at the end extends one piece
+    for (size_t i = 0; i < 1000; i++)
+        ASSERT_EQ(my_str_piece_insert(&table, my_str_piece_size(&table), my_str_view_cstr("z")), 0);
+    ASSERT_EQ(pieces(), 2);
+    ASSERT_EQ(content(), original + std::string(1000, 'z'));
+
+    // typing in the middle too
+    for (size_t i = 0; i < 100; i++)
+        ASSERT_EQ(my_str_piece_insert(&table, 4 + i, my_str_view_cstr("y")), 0);
+    ASSERT_EQ(pieces(), 4);
+    ASSERT_EQ(content(0, 110), "The " + std::string(100, 'y') + "quick ");
+}
+
+TEST_F(PieceDeclaration, my_str_piece_snapshot) {
+    std::vector<my_str_piece_snapshot_t> snapshots;
+    std::vector<std::string> states;
+    std::string expected = original;
+
+    for (size_t i = 0; i < 50; i++) {
+        snapshots.emplace_back();
+        ASSERT_EQ(my_str_piece_snapshot(&table, &snapshots.back()), 0);
+        states.push_back(expected);
+        for (size_t j = 0; j < 30; j++)
+            random_edit(expected);
+    }
+    ASSERT_EQ(content(), expected);
+
+    // undo in reverse order, then redo of a random state
+    for (size_t i = snapshots.size(); i-- > 0;) {
+        ASSERT_EQ(my_str_piece_restore(&table, &snapshots[i]), 0);
+        ASSERT_EQ(content(), states[i]) << i;
+    }
+    ASSERT_EQ(my_str_piece_restore(&table, &snapshots[25]), 0);
+    random_edit(states[25]);
+    ASSERT_EQ(content(), states[25]);
+    ASSERT_EQ(my_str_piece_restore(&table, &snapshots[40]), 0);
+    ASSERT_EQ(content(), states[40]);
+
+    for (auto &snapshot: snapshots)
+        ASSERT_EQ(my_str_piece_release(&table, &snapshot), 0);
+    ASSERT_EQ(content(), states[40]);
+
+    ASSERT_EQ(my_str_piece_snapshot(&table, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_piece_restore(nullptr, &snapshots[0]), NULL_PTR_ERR);
+}
+
+TEST_F(PieceDeclaration, my_str_piece_write_file) {
+    my_str_piece_erase(&table, 4, 6);
+    my_str_piece_insert(&table, 4, my_str_view_cstr("slow "));
+    my_str_piece_insert(&table, my_str_piece_size(&table), my_str_view_cstr("!"));
+    std::string expected = "The slow brown fox jumps over the lazy dog!";
+
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(my_str_piece_write_file(&table, file), 0);
+    rewind(file);
+    std::string written(expected.size() + 1, '\0');
+    written.resize(fread(&written[0], 1, written.size(), file));
+    fclose(file);
+    ASSERT_EQ(written, expected);
+
+    my_str_t str;
+    my_str_create(&str, 0);
+    ASSERT_EQ(my_str_piece_to_str(&table, &str), 0);
+    ASSERT_EQ(std::string(str.data, str.size_m), expected);
+    my_str_free(&str);
+
+    ASSERT_EQ(my_str_piece_write_file(&table, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_piece_to_str(nullptr, &str), NULL_PTR_ERR);
+
+    my_str_piece_table_t empty;
+    ASSERT_EQ(my_str_piece_create(&empty, my_str_view_t{nullptr, 0}), 0);
+    ASSERT_EQ(my_str_piece_size(&empty), 0);
+    ASSERT_EQ(my_str_piece_insert(&empty, 0, my_str_view_cstr("new")), 0);
+    ASSERT_EQ(my_str_piece_size(&empty), 3);
+    my_str_piece_free(&empty);
+    ASSERT_EQ(my_str_piece_create(&empty, my_str_view_t{nullptr, 1}), NULL_PTR_ERR);
+}
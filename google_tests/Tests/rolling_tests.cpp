@@ -0,0 +1,155 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "c_string_rolling.h"
+}
+
+namespace {
+    class RollingDeclaration : public testing::Test {
+    protected:
+        my_str_rolling_t roll{};
+        std::string text;
+
+        void SetUp() override {
+            my_str_rolling_create(&roll, 8);
+        }
+
+        void TearDown() override {
+            my_str_rolling_free(&roll);
+        }
+
+        void make_text(size_t size, unsigned seed) {
+            std::mt19937 gen{seed};
+            text.clear();
+            for (size_t i = 0; i < size; i++)
+                text.push_back(static_cast<char>("abcd\x80"[gen() % 5]));
+        }
+
+        my_str_view_t view() const {
+            return my_str_view_t{text.data(), text.size()};
+        }
+
+        static int save_match(size_t position, size_t pattern_id, void* arg) {
+            static_cast<std::vector<std::pair<size_t, size_t>> *>(arg)->emplace_back(position, pattern_id);
+            return 0;
+        }
+
+        static int save_boundary(size_t position, void* arg) {
+            static_cast<std::vector<size_t> *>(arg)->push_back(position);
+            return 0;
+        }
+
+        std::vector<size_t> boundaries() const {
+            std::vector<size_t> result;
+            EXPECT_EQ(my_str_rolling_scan(&roll, view(), nullptr, save_boundary, &result), 0);
+            return result;
+        }
+    };
+}
+
+TEST_F(RollingDeclaration, my_str_rolling_hashes) {
+    make_text(1000, 1);
+    std::vector<uint64_t> hashes(text.size() - roll.window + 1);
+    ASSERT_EQ(my_str_rolling_hashes(&roll, view(), hashes.data()), 0);
+    for (size_t i = 0; i < hashes.size(); i++)
+        ASSERT_EQ(hashes[i], my_str_rolling_hash(&roll, my_str_view_t{text.data() + i, roll.window}));
+
+    // equal windows have equal hashes
+    ASSERT_EQ(my_str_rolling_hash(&roll, my_str_view_cstr("abcdabcd")), my_str_rolling_hash(&roll, my_str_view_cstr("abcdabcd")));
+    ASSERT_NE(my_str_rolling_hash(&roll, my_str_view_cstr("abcdabcd")), my_str_rolling_hash(&roll, my_str_view_cstr("abcdabce")));
+
+    uint64_t untouched = 7;
+    ASSERT_EQ(my_str_rolling_hashes(&roll, my_str_view_cstr("short"), &untouched), 0);
+    ASSERT_EQ(untouched, 7);
+    ASSERT_EQ(my_str_rolling_hashes(&roll, view(), nullptr), NULL_PTR_ERR);
+
+    my_str_rolling_t bad;
+    ASSERT_EQ(my_str_rolling_create(&bad, 0), RANGE_ERR);
+    ASSERT_EQ(my_str_rolling_create(nullptr, 8), NULL_PTR_ERR);
+}
+
+TEST_F(RollingDeclaration, my_str_rolling_add_pattern) {
+    make_text(20000, 2);
+
+    std::vector<std::string> patterns;
+    for (size_t i = 0; i < 300; i++) {
+        std::string pattern = text.substr(i * 61 % (text.size() - 8), 8);
+        size_t id = 0;
+        int res = my_str_rolling_add_pattern(&roll, my_str_view_t{pattern.data(), pattern.size()}, &id);
+        if (res == 0) {
+            ASSERT_EQ(id, patterns.size());
+            patterns.push_back(pattern);
+        } else {
+            ASSERT_EQ(res, 1);
+            ASSERT_EQ(patterns[id], pattern);
+        }
+    }
+    ASSERT_EQ(my_str_rolling_add_pattern(&roll, my_str_view_cstr("zzzzzzzz"), nullptr), 0);
+    patterns.push_back("zzzzzzzz");
+
+    std::vector<std::pair<size_t, size_t>> matches;
+    ASSERT_EQ(my_str_rolling_scan(&roll, view(), save_match, nullptr, &matches), 0);
+
+    std::vector<std::pair<size_t, size_t>> expected;
+    for (size_t pos = 0; pos + 8 <= text.size(); pos++)
+        for (size_t id = 0; id < patterns.size(); id++)
+            if (text.compare(pos, 8, patterns[id]) == 0)
+                expected.emplace_back(pos, id);
+    ASSERT_EQ(matches, expected);
+
+    ASSERT_EQ(my_str_rolling_add_pattern(&roll, my_str_view_cstr("abc"), nullptr), RANGE_ERR);
+    ASSERT_EQ(my_str_rolling_add_pattern(nullptr, my_str_view_cstr("abcdabcd"), nullptr), NULL_PTR_ERR);
+}
+
+TEST_F(RollingDeclaration, my_str_rolling_scan) {
+    make_text(1 << 20, 3);
+    ASSERT_EQ(my_str_rolling_set_chunking(&roll, 1024, 4096, 16384), 0);
+
+    std::vector<size_t> ends = boundaries();
+    ASSERT_FALSE(ends.empty());
+    ASSERT_EQ(ends.back(), text.size());
+    size_t start = 0;
+    for (size_t i = 0; i < ends.size(); i++) {
+        ASSERT_LE(ends[i] - start, 16384);
+        if (i + 1 < ends.size()) {
+            ASSERT_GE(ends[i] - start, 1024);
+        }
+        start = ends[i];
+    }
+    // on random data average size is close to min + avg
+    ASSERT_GT(ends.size(), text.size() / (1024 + 4096) / 2);
+    ASSERT_LT(ends.size(), text.size() / (1024 + 4096) * 2);
+
+    // boundaries are found again after inserted data, so most chunks stay the same
+    std::string original = text;
+    text = std::string(100, 'x') + original;
+    std::vector<size_t> shifted = boundaries();
+    size_t same = 0;
+    for (size_t end: shifted)
+        if (end >= 100 && std::binary_search(ends.begin(), ends.end(), end - 100))
+            same++;
+    ASSERT_GE(same + 3, ends.size());
+
+    // maximal size cuts chunks of data without boundaries, even before the first window
+    ASSERT_EQ(my_str_rolling_set_chunking(&roll, 0, 1ull << 40, 3), 0);
+    text = "aaaaaaaaaa";
+    ASSERT_EQ(boundaries(), (std::vector<size_t>{3, 6, 9, 10}));
+    text = "";
+    ASSERT_TRUE(boundaries().empty());
+
+    ASSERT_EQ(my_str_rolling_set_chunking(&roll, 5, 4, 3), RANGE_ERR);
+    ASSERT_EQ(my_str_rolling_scan(nullptr, view(), nullptr, nullptr, nullptr), NULL_PTR_ERR);
+
+    // non zero value of callback stops the scan
+    text = original;
+    auto stop = [](size_t, void*) { return 5; };
+    ASSERT_EQ(my_str_rolling_scan(&roll, view(), nullptr, stop, nullptr), 5);
+}
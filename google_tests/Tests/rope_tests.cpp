@@ -0,0 +1,157 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+extern "C" {
+#include "c_string_rope.h"
+}
+
+namespace {
+    class RopeDeclaration : public testing::Test {
+    protected:
+        my_rope_t rope{};
+        std::mt19937 gen{5};
+
+        void SetUp() override {
+            my_rope_create(&rope);
+        }
+
+        void TearDown() override {
+            my_rope_free(&rope);
+        }
+
+        std::string random_string(size_t size) {
+            std::string result;
+            for (size_t i = 0; i < size; i++)
+                result.push_back(static_cast<char>('a' + gen() % 3));
+            return result;
+        }
+
+        static int append_chunk(const char* chunk, size_t size, void* arg) {
+            static_cast<std::string *>(arg)->append(chunk, size);
+            return 0;
+        }
+
+        // parents have bigger priorities, otherwise tree is not balanced
+        static bool heap_ordered(const my_rope_node_t* node) {
+            if (!node)
+                return true;
+            if ((node->left && node->left->priority > node->priority) ||
+                (node->right && node->right->priority > node->priority))
+                return false;
+            return heap_ordered(node->left) && heap_ordered(node->right);
+        }
+
+        std::string content(size_t pos = 0, size_t size = SIZE_MAX) {
+            std::string result;
+            EXPECT_EQ(my_rope_for_each(&rope, pos, size, append_chunk, &result), 0);
+            return result;
+        }
+    };
+}
+
+TEST_F(RopeDeclaration, my_rope_insert) {
+    std::string expected;
+    for (size_t i = 0; i < 3000; i++) {
+        size_t pos = gen() % (expected.size() + 1);
+        // mostly small edits, sometimes chunks of several nodes
+        std::string data = random_string(i % 50 == 0 ? gen() % 10000 : gen() % 20);
+        ASSERT_EQ(my_rope_insert(&rope, pos, my_str_view_t{data.data(), data.size()}), 0);
+        expected.insert(pos, data);
+        ASSERT_EQ(my_rope_size(&rope), expected.size());
+    }
+    ASSERT_EQ(content(), expected);
+    ASSERT_TRUE(heap_ordered(rope.root));
+
+    char c = 0;
+    for (size_t i = 0; i < expected.size(); i += 997) {
+        ASSERT_EQ(my_rope_get(&rope, i, &c), 0);
+        ASSERT_EQ(c, expected[i]);
+    }
+    ASSERT_EQ(my_rope_get(&rope, expected.size(), &c), RANGE_ERR);
+    ASSERT_EQ(content(1000, 5000), expected.substr(1000, 5000));
+    ASSERT_EQ(content(expected.size(), 10), "");
+
+    ASSERT_EQ(my_rope_insert(&rope, expected.size() + 1, my_str_view_cstr("a")), RANGE_ERR);
+    ASSERT_EQ(my_rope_insert(nullptr, 0, my_str_view_cstr("a")), NULL_PTR_ERR);
+    ASSERT_EQ(my_rope_for_each(&rope, expected.size() + 1, 1, append_chunk, nullptr), RANGE_ERR);
+    ASSERT_EQ(my_rope_for_each(&rope, 0, 1, nullptr, nullptr), NULL_PTR_ERR);
+}
+
+TEST_F(RopeDeclaration, my_rope_erase) {
+    std::string expected = random_string(200000);
+    ASSERT_EQ(my_rope_insert(&rope, 0, my_str_view_t{expected.data(), expected.size()}), 0);
+
+    for (size_t i = 0; i < 3000 && !expected.empty(); i++) {
+        size_t pos = gen() % (expected.size() + 1);
+        size_t size = i % 20 == 0 ? gen() % 5000 : gen() % 10;
+        ASSERT_EQ(my_rope_erase(&rope, pos, size), 0);
+        expected.erase(pos, size);
+        if (i % 2) {
+            std::string data = random_string(gen() % 30);
+            ASSERT_EQ(my_rope_insert(&rope, pos, my_str_view_t{data.data(), data.size()}), 0);
+            expected.insert(pos, data);
+        }
+        ASSERT_EQ(my_rope_size(&rope), expected.size());
+    }
+    ASSERT_EQ(content(), expected);
+
+    ASSERT_EQ(my_rope_erase(&rope, 0, SIZE_MAX), 0);
+    ASSERT_EQ(my_rope_size(&rope), 0);
+    ASSERT_EQ(my_rope_erase(&rope, 1, 1), RANGE_ERR);
+    ASSERT_EQ(my_rope_erase(nullptr, 0, 1), NULL_PTR_ERR);
+}
+
+TEST_F(RopeDeclaration, my_rope_find) {
+    std::string expected;
+    for (size_t i = 0; i < 200; i++) {
+        std::string data = random_string(gen() % 500);
+        size_t pos = gen() % (expected.size() + 1);
+        my_rope_insert(&rope, pos, my_str_view_t{data.data(), data.size()});
+        expected.insert(pos, data);
+    }
+
+    for (const char* pattern: {"abcab", "cccc", "aaaaaaaaaaaaaa", "b"}) {
+        size_t from = 0, pos = 0;
+        while (true) {
+            size_t naive = expected.find(pattern, from);
+            int res = my_rope_find(&rope, from, my_str_view_cstr(pattern), &pos);
+            if (naive == std::string::npos) {
+                ASSERT_EQ(res, NOT_FOUND_CODE);
+                break;
+            }
+            ASSERT_EQ(res, 0);
+            ASSERT_EQ(pos, naive);
+            from = pos + 1 + gen() % 300;
+            if (from > expected.size())
+                break;
+        }
+    }
+
+    size_t pos = 0;
+    ASSERT_EQ(my_rope_find(&rope, 0, my_str_view_cstr(""), &pos), NOT_FOUND_CODE);
+    ASSERT_EQ(my_rope_find(&rope, expected.size() + 1, my_str_view_cstr("a"), &pos), RANGE_ERR);
+    ASSERT_EQ(my_rope_find(&rope, 0, my_str_view_cstr("a"), nullptr), NULL_PTR_ERR);
+}
+
+TEST_F(RopeDeclaration, my_rope_to_str) {
+    std::string expected = random_string(10000);
+    my_rope_insert(&rope, 0, my_str_view_t{expected.data(), expected.size()});
+    my_rope_insert(&rope, 5000, my_str_view_cstr("middle"));
+    expected.insert(5000, "middle");
+
+    my_str_t str;
+    my_str_create(&str, 0);
+    my_str_from_cstr(&str, "old content", 0);
+    ASSERT_EQ(my_rope_to_str(&rope, &str), 0);
+    ASSERT_EQ(std::string(str.data, str.size_m), expected);
+
+    my_rope_free(&rope);
+    ASSERT_EQ(my_rope_to_str(&rope, &str), 0);
+    ASSERT_EQ(my_str_size(&str), 0);
+    ASSERT_EQ(my_rope_to_str(&rope, nullptr), NULL_PTR_ERR);
+    my_str_free(&str);
+}
@@ -0,0 +1,118 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+extern "C" {
+#include "c_string_sort.h"
+}
+
+namespace {
+    class SortDeclaration : public testing::Test {
+    protected:
+        std::vector<std::string> words;
+
+        // short keys with long common prefixes, duplicates, empty strings and bytes above 127
+        void make_words(size_t count) {
+            std::mt19937 gen{7};
+            words.clear();
+            for (size_t i = 0; i < count; i++) {
+                std::string word(gen() % 3 == 0 ? "common/prefix/" : "");
+                size_t size = gen() % 9;
+                for (size_t j = 0; j < size; j++)
+                    word.push_back(static_cast<char>("ab\xff\x01z"[gen() % 5]));
+                words.push_back(word);
+            }
+        }
+
+        std::vector<std::string> sorted_words() const {
+            std::vector<std::string> sorted = words;
+            std::sort(sorted.begin(), sorted.end(), [](const std::string &a, const std::string &b) {
+                size_t n = std::min(a.size(), b.size());
+                int res = memcmp(a.data(), b.data(), n);
+                return res < 0 || (res == 0 && a.size() < b.size());
+            });
+            return sorted;
+        }
+
+        std::vector<my_str_view_t> views() const {
+            std::vector<my_str_view_t> result;
+            for (auto &word: words)
+                result.push_back(my_str_view_t{word.data(), word.size()});
+            return result;
+        }
+    };
+}
+
+TEST_F(SortDeclaration, my_str_sort) {
+    make_words(5000);
+    std::vector<std::string> expected = sorted_words();
+
+    for (int flags: {0, MY_STR_SORT_STABLE, MY_STR_SORT_PARALLEL, MY_STR_SORT_STABLE | MY_STR_SORT_PARALLEL}) {
+        std::vector<my_str_t> strs(words.size());
+        for (size_t i = 0; i < words.size(); i++) {
+            my_str_create(&strs[i], 0);
+            my_str_t &str = strs[i];
+            my_str_reserve(&str, words[i].size());
+            memcpy(str.data, words[i].data(), words[i].size());
+            str.size_m = words[i].size();
+        }
+
+        ASSERT_EQ(my_str_sort(strs.data(), strs.size(), flags), 0);
+        for (size_t i = 0; i < strs.size(); i++)
+            ASSERT_EQ(std::string(strs[i].data, strs[i].size_m), expected[i]) << flags;
+
+        for (auto &str: strs)
+            my_str_free(&str);
+    }
+
+    // nothing to sort
+    ASSERT_EQ(my_str_sort(nullptr, 0, 0), 0);
+    ASSERT_EQ(my_str_sort(nullptr, 2, 0), NULL_PTR_ERR);
+}
+
+TEST_F(SortDeclaration, my_str_sort_views) {
+    make_words(MY_STR_SORT_PARALLEL_MIN + 1000);
+    std::vector<std::string> expected = sorted_words();
+
+    for (int flags: {0, MY_STR_SORT_STABLE, MY_STR_SORT_PARALLEL, MY_STR_SORT_STABLE | MY_STR_SORT_PARALLEL}) {
+        std::vector<my_str_view_t> sorted = views();
+        ASSERT_EQ(my_str_sort_views(sorted.data(), sorted.size(), flags), 0);
+        for (size_t i = 0; i < sorted.size(); i++)
+            ASSERT_EQ(std::string(sorted[i].data, sorted[i].size_m), expected[i]) << flags;
+
+        // equal strings keep their order in stable mode
+        if (flags & MY_STR_SORT_STABLE) {
+            std::unordered_map<const char *, size_t> positions;
+            for (size_t i = 0; i < words.size(); i++)
+                positions[words[i].data()] = i;
+            for (size_t i = 1; i < sorted.size(); i++) {
+                if (expected[i] == expected[i - 1]) {
+                    ASSERT_LT(positions[sorted[i - 1].data], positions[sorted[i].data]);
+                }
+            }
+        }
+    }
+
+    ASSERT_EQ(my_str_sort_views(nullptr, 2, 0), NULL_PTR_ERR);
+}
+
+TEST_F(SortDeclaration, my_str_sort_nested_prefixes) {
+    // one key ends at every depth, radix sort must not recurse once per byte
+    std::string text(20000, 'a');
+    std::vector<my_str_view_t> prefixes;
+    for (size_t i = 0; i < text.size(); i++)
+        prefixes.push_back(my_str_view_t{text.data(), text.size() - i});
+
+    for (int flags: {MY_STR_SORT_STABLE, MY_STR_SORT_STABLE | MY_STR_SORT_PARALLEL}) {
+        std::vector<my_str_view_t> sorted = prefixes;
+        ASSERT_EQ(my_str_sort_views(sorted.data(), sorted.size(), flags), 0);
+        for (size_t i = 0; i < sorted.size(); i++)
+            ASSERT_EQ(sorted[i].size_m, i + 1) << flags;
+    }
+}
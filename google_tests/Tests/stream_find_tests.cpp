@@ -0,0 +1,90 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "c_string_stream_find.h"
+}
+
+namespace {
+    class StreamFindDeclaration : public testing::Test {
+    protected:
+        my_str_stream_find_t state{};
+        std::vector<size_t> found;
+
+        void TearDown() override {
+            my_str_stream_find_free(&state);
+        }
+
+        // feeds text split into chunks of given size
+        void feed(const std::string &text, size_t chunk) {
+            for (size_t i = 0; i < text.size(); i += chunk) {
+                my_str_view_t view = {text.data() + i, std::min(chunk, text.size() - i)};
+                ASSERT_EQ(my_str_stream_find_feed(&state, view, collect, &found), 0);
+            }
+        }
+
+        static int collect(size_t position, void *arg) {
+            static_cast<std::vector<size_t> *>(arg)->push_back(position);
+            return 0;
+        }
+    };
+
+    int stop_search(size_t, void *) {
+        return 1;
+    }
+}
+
+TEST_F(StreamFindDeclaration, my_str_stream_find_feed) {
+    std::string text;
+    for (size_t i = 0; i < 5000; i++)
+        text.push_back("ab"[(i * i + i / 7) % 3 == 0]);
+
+    for (const char *pattern: {"abab", "aab", "b", "bbbabba", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"}) {
+        std::vector<size_t> expected;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+            expected.push_back(pos);
+
+        // every chunk size finds the same matches, including ones on chunk edges
+        for (size_t chunk: {1, 2, 3, 7, 64, 5000}) {
+            ASSERT_EQ(my_str_stream_find_create(&state, my_str_view_cstr(pattern)), 0);
+            found.clear();
+            feed(text, chunk);
+            ASSERT_EQ(found, expected) << pattern << " " << chunk;
+            my_str_stream_find_free(&state);
+        }
+    }
+
+    // overlapping matches
+    ASSERT_EQ(my_str_stream_find_create(&state, my_str_view_cstr("aa")), 0);
+    found.clear();
+    feed("aaaa", 1);
+    ASSERT_EQ(found, (std::vector<size_t>{0, 1, 2}));
+
+    // reset forgets the partial match and offsets
+    ASSERT_EQ(my_str_stream_find_reset(&state), 0);
+    found.clear();
+    feed("a", 1);
+    ASSERT_EQ(my_str_stream_find_reset(&state), 0);
+    feed("ab", 1);
+    ASSERT_EQ(found, std::vector<size_t>{});
+
+    // callback stops the search
+    ASSERT_EQ(my_str_stream_find_feed(&state, my_str_view_cstr("baab"), stop_search, nullptr), 1);
+
+    // empty pattern never matches
+    my_str_stream_find_free(&state);
+    ASSERT_EQ(my_str_stream_find_create(&state, my_str_view_cstr("")), 0);
+    found.clear();
+    feed("hello", 2);
+    ASSERT_TRUE(found.empty());
+
+    // bad arguments
+    ASSERT_EQ(my_str_stream_find_create(nullptr, my_str_view_cstr("a")), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_stream_find_feed(nullptr, my_str_view_cstr("a"), collect, &found), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_stream_find_feed(&state, my_str_view_cstr("a"), nullptr, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_stream_find_reset(nullptr), NULL_PTR_ERR);
+}
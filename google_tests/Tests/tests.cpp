@@ -14,6 +14,7 @@
 #include <fstream>
 #include <memory>
 #include <exception>
+#include <set>
 
 #ifndef FILE_DIR
 #define FILE_DIR "../google_tests/test_files"
@@ -28,6 +29,7 @@ extern "C" {
 #include "c_string.h"
 #include <string.h>
 #include <stdint.h>
+#include <unistd.h>
 }
 
 static size_t test_c_str_len(const char *string) {
@@ -792,6 +794,85 @@ TEST_F(ClassDeclaration, my_str_substr_cstr) {
     ASSERT_STREQ(my_str_get_cstr(&string2), "");
 }
 
+TEST_F(ClassDeclaration, my_str_substr_shared) {
+    std::string text;
+    for (size_t i = 0; i < 200; i++)
+        text.push_back(static_cast<char>('a' + i % 26));
+    my_str_from_cstr(&string1, text.c_str(), 0);
+
+    // slice points into the buffer of parent
+    ASSERT_EQ(my_str_substr_shared(&string1, &string2, 10, 110), 0);
+    ASSERT_NE(string2.shared, nullptr);
+    ASSERT_EQ(string1.shared, string2.shared);
+    ASSERT_EQ(string2.data, string1.data + 10);
+    ASSERT_EQ(string2.shared->refs, 2);
+    ASSERT_EQ(std::string(string2.data, string2.size_m), text.substr(10, 100));
+
+    // terminating zero would overwrite byte of parent, so slice is copied
+    ASSERT_EQ(std::string(my_str_get_cstr(&string2)), text.substr(10, 100));
+    ASSERT_EQ(string2.shared, nullptr);
+    ASSERT_EQ(string1.shared->refs, 1);
+    ASSERT_EQ(std::string(string1.data, string1.size_m), text);
+
+    // slice to the end is not copied, writing does not touch parent
+    ASSERT_EQ(my_str_substr_shared(&string1, &string2, 100, 500), 0);
+    ASSERT_EQ(std::string(my_str_get_cstr(&string2)), text.substr(100));
+    ASSERT_EQ(string2.data, string1.data + 100);
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+    my_str_substr_shared(&string1, &string3, 0, 100);
+    ASSERT_EQ(my_str_write_file(&string3, file), 0);
+    ASSERT_EQ(std::string(string1.data, string1.size_m), text);
+    fclose(file);
+
+    // changed string is copied, the others keep the content
+    ASSERT_EQ(my_str_putc(&string1, 150, 'X'), 0);
+    ASSERT_EQ(string1.shared, nullptr);
+    ASSERT_EQ(std::string(string2.data, string2.size_m), text.substr(100));
+    ASSERT_EQ(my_str_append_c(&string3, 'Y'), 0);
+    ASSERT_EQ(std::string(my_str_get_cstr(&string3)), text.substr(0, 100) + "Y");
+    ASSERT_EQ(std::string(string2.data, string2.size_m), text.substr(100));
+    ASSERT_EQ(my_str_cmp(&string2, &string2), 0);
+
+    // the last slice keeps buffer alive and takes it when it is changed
+    ASSERT_EQ(string2.shared->refs, 1);
+    ASSERT_EQ(my_str_erase(&string2, 0, 50), 0);
+    ASSERT_EQ(string2.shared, nullptr);
+    ASSERT_EQ(std::string(my_str_get_cstr(&string2)), text.substr(150));
+
+    // short slices are just copied
+    ASSERT_EQ(my_str_substr_shared(&string1, &string2, 0, MY_STR_SHARE_MIN - 1), 0);
+    ASSERT_EQ(string2.shared, nullptr);
+    ASSERT_EQ(std::string(my_str_get_cstr(&string2)), text.substr(0, MY_STR_SHARE_MIN - 1));
+
+    ASSERT_EQ(my_str_substr_shared(&string1, &string1, 0, 1), RANGE_ERR);
+    ASSERT_EQ(my_str_substr_shared(&string1, &string2, 5, 4), RANGE_ERR);
+    ASSERT_EQ(my_str_substr_shared(&string1, &string2, 201, 300), RANGE_ERR);
+    ASSERT_EQ(my_str_substr_shared(nullptr, &string2, 0, 1), NULL_PTR_ERR);
+}
+
+TEST_F(ClassDeclaration, my_str_compact) {
+    std::string text(10000, 'q');
+    my_str_from_cstr(&string1, text.c_str(), 0);
+    my_str_substr_shared(&string1, &string2, 0, 5000);
+    my_str_substr_shared(&string1, &string3, 100, 200);
+    my_str_free(&string1);
+
+    // big slice stays shared, tiny one does not keep the buffer any more
+    ASSERT_EQ(my_str_compact(&string2), 0);
+    ASSERT_NE(string2.shared, nullptr);
+    ASSERT_EQ(my_str_compact(&string3), 0);
+    ASSERT_EQ(string3.shared, nullptr);
+    ASSERT_EQ(string2.shared->refs, 1);
+    ASSERT_EQ(std::string(my_str_get_cstr(&string3)), text.substr(100, 100));
+
+    // strings that do not share buffers are not changed
+    ASSERT_EQ(my_str_compact(&string3), 0);
+    ASSERT_EQ(my_str_compact(nullptr), NULL_PTR_ERR);
+
+    my_str_create(&string1, 0);
+}
+
 TEST_F(ClassDeclaration, my_str_erase) {
     my_str_from_cstr(&string1, "hello_world", 20);
 
@@ -857,6 +938,110 @@ TEST_F(ClassDeclaration, my_str_reserve) {
     ASSERT_TRUE((errcode1 == MEMORY_ALLOCATION_ERR) || (errcode2 == MEMORY_ALLOCATION_ERR));
 }
 
+TEST_F(ClassDeclaration, my_str_buffer_padding) {
+    auto check = [](const my_str_t &str) {
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(str.data) % MY_STR_ALIGN, 0);
+        for (size_t i = 1; i <= MY_STR_PADDING; i++)
+            ASSERT_EQ(str.data[str.capacity_m + i], '\0') << i;
+    };
+
+    check(string1);
+    check(string3);
+    my_str_from_cstr(&string1, "hello", 0);
+    check(string1);
+    my_str_reserve(&string1, 1000);
+    check(string1);
+    ASSERT_STREQ(my_str_get_cstr(&string1), "hello");
+    my_str_shrink_to_fit(&string1);
+    check(string1);
+    ASSERT_STREQ(my_str_get_cstr(&string1), "hello");
+
+    // copy of shared substring gets own buffer
+    std::string text(100, 'x');
+    my_str_from_cstr(&string2, text.c_str(), 0);
+    my_str_substr_shared(&string2, &string3, 10, 90);
+    my_str_putc(&string3, 0, 'y');
+    check(string3);
+}
+
+TEST_F(ClassDeclaration, my_str_huge_buffer) {
+    auto check = [](const my_str_t &str) {
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(str.data) % MY_STR_HUGE_PAGE, 0);
+        for (size_t i = 1; i <= MY_STR_PADDING; i++)
+            ASSERT_EQ(str.data[str.capacity_m + i], '\0') << i;
+    };
+
+    my_str_from_cstr(&string1, "huge", 0);
+    ASSERT_EQ(my_str_reserve(&string1, MY_STR_HUGE_MIN), 0);
+    check(string1);
+
+    // growth and shrinking keep content, alignment and padding
+    ASSERT_EQ(my_str_resize(&string1, MY_STR_HUGE_MIN + 10, 'a'), 0);
+    check(string1);
+    ASSERT_EQ(my_str_putc(&string1, MY_STR_HUGE_MIN + 5, 'b'), 0);
+    ASSERT_EQ(my_str_find_c(&string1, 'b', 0), static_cast<int>(MY_STR_HUGE_MIN + 5));
+    my_str_popback(&string1);
+    ASSERT_EQ(my_str_shrink_to_fit(&string1), 0);
+    check(string1);
+    ASSERT_EQ(my_str_capacity(&string1), MY_STR_HUGE_MIN + 9);
+    char start[7] = {0};
+    ASSERT_EQ(my_str_substr_cstr(&string1, start, 0, 6), 0);
+    ASSERT_STREQ(start, "hugeaa");
+
+    // small buffer again
+    my_str_resize(&string1, 4, ' ');
+    ASSERT_EQ(my_str_shrink_to_fit(&string1), 0);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(string1.data) % MY_STR_ALIGN, 0);
+    ASSERT_STREQ(my_str_get_cstr(&string1), "huge");
+}
+
+TEST_F(ClassDeclaration, my_str_reserve_uninit) {
+    my_str_from_cstr(&string1, "value: ", 0);
+
+    char* spare = nullptr;
+    ASSERT_EQ(my_str_reserve_uninit(&string1, 30, &spare), 0);
+    ASSERT_GE(my_str_capacity(&string1), 37);
+    ASSERT_EQ(spare, string1.data + 7);
+    int written = snprintf(spare, 30, "%d", 12345);
+    ASSERT_EQ(my_str_commit(&string1, written), 0);
+    ASSERT_STREQ(my_str_get_cstr(&string1), "value: 12345");
+
+    // grows at least twice, so appending in small pieces is amortized O(1)
+    size_t capacity = my_str_capacity(&string1);
+    ASSERT_EQ(my_str_reserve_uninit(&string1, capacity, &spare), 0);
+    ASSERT_GE(my_str_capacity(&string1), 2 * capacity);
+    ASSERT_EQ(my_str_commit(&string1, 0), 0);
+
+    ASSERT_EQ(my_str_commit(&string1, my_str_capacity(&string1) - my_str_size(&string1) + 1), RANGE_ERR);
+    ASSERT_EQ(my_str_reserve_uninit(&string1, 1, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_reserve_uninit(nullptr, 1, &spare), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_reserve_uninit(&string1, SIZE_MAX, &spare), MEMORY_ALLOCATION_ERR);
+    ASSERT_EQ(my_str_commit(nullptr, 1), NULL_PTR_ERR);
+}
+
+TEST_F(ClassDeclaration, my_str_resize_and_overwrite) {
+    my_str_from_cstr(&string1, "abc", 0);
+
+    // old content is kept, callback appends to it
+    auto repeat = [](char* data, size_t max_size, void*) -> size_t {
+        for (size_t i = 3; i < max_size; i++)
+            data[i] = data[i % 3];
+        return max_size;
+    };
+    ASSERT_EQ(my_str_resize_and_overwrite(&string1, 10, repeat, nullptr), 0);
+    ASSERT_STREQ(my_str_get_cstr(&string1), "abcabcabca");
+
+    auto shorter = [](char*, size_t, void* arg) -> size_t { return *static_cast<size_t *>(arg); };
+    size_t size = 4;
+    ASSERT_EQ(my_str_resize_and_overwrite(&string1, 10, shorter, &size), 0);
+    ASSERT_STREQ(my_str_get_cstr(&string1), "abca");
+
+    size = 11;
+    ASSERT_EQ(my_str_resize_and_overwrite(&string1, 10, shorter, &size), RANGE_ERR);
+    ASSERT_EQ(my_str_size(&string1), 0);
+    ASSERT_EQ(my_str_resize_and_overwrite(&string1, 10, nullptr, nullptr), NULL_PTR_ERR);
+}
+
 TEST_F(ClassDeclaration, my_str_shrink_to_fit) {
     my_str_from_cstr(&string1, "hello, world", 20);
 
@@ -874,6 +1059,50 @@ TEST_F(ClassDeclaration, my_str_shrink_to_fit) {
     ASSERT_EQ(my_str_shrink_to_fit(nullptr), NULL_PTR_ERR);
 }
 
+TEST_F(ClassDeclaration, my_str_set_shrink_policy) {
+    // off by default
+    ASSERT_EQ(my_str_get_shrink_policy().trigger, 0);
+    ASSERT_EQ(my_str_set_shrink_policy(my_str_shrink_policy_t{4, 2, 16}), 0);
+
+    std::string text(1000, 'a');
+    my_str_from_cstr(&string1, text.c_str(), 0);
+    ASSERT_EQ(my_str_capacity(&string1), 1000);
+
+    // buffer shrinks only when size falls below a quarter of capacity
+    ASSERT_EQ(my_str_erase(&string1, 0, 700), 0);
+    ASSERT_EQ(my_str_capacity(&string1), 1000);
+    ASSERT_EQ(my_str_erase(&string1, 0, 100), 0);
+    ASSERT_EQ(my_str_capacity(&string1), 400);
+    ASSERT_EQ(std::string(my_str_get_cstr(&string1)), text.substr(0, 200));
+
+    // alternating append and popback at the edge never reallocates
+    my_str_resize(&string1, 99, 'a');
+    size_t capacity = my_str_capacity(&string1);
+    for (size_t i = 0; i < 100; i++) {
+        my_str_append_c(&string1, 'b');
+        my_str_popback(&string1);
+        ASSERT_EQ(my_str_capacity(&string1), capacity);
+    }
+    // 198 -> 98 -> 48 -> 22, every time size falls below a quarter
+    while (my_str_size(&string1) > 10)
+        ASSERT_EQ(my_str_popback(&string1), 'a');
+    ASSERT_EQ(my_str_capacity(&string1), 22);
+
+    // clear keeps the buffer for refilling
+    ASSERT_EQ(my_str_clear(&string1), 0);
+    ASSERT_EQ(my_str_capacity(&string1), 22);
+
+    // never below minimal capacity
+    my_str_resize(&string1, 10, 'a');
+    ASSERT_EQ(my_str_erase(&string1, 0, 10), 0);
+    ASSERT_EQ(my_str_capacity(&string1), 16);
+    ASSERT_STREQ(my_str_get_cstr(&string1), "");
+
+    ASSERT_EQ(my_str_set_shrink_policy(my_str_shrink_policy_t{4, 4, 0}), RANGE_ERR);
+    ASSERT_EQ(my_str_set_shrink_policy(my_str_shrink_policy_t{4, 0, 0}), RANGE_ERR);
+    ASSERT_EQ(my_str_set_shrink_policy(my_str_shrink_policy_t{0, 0, 0}), 0);
+}
+
 TEST_F(ClassDeclaration, my_str_resize) {
     my_str_from_cstr(&string1, "hello, world", 20);
 
@@ -956,6 +1185,149 @@ TEST_F(ClassDeclaration, my_str_find) {
     ASSERT_EQ(my_str_find(&string1, &string2, 19), static_cast<size_t>(NOT_FOUND_CODE));
 }
 
+TEST_F(ClassDeclaration, my_str_find_pos) {
+    my_str_from_cstr(&string1, "hello, world, hello", 0);
+    my_str_from_cstr(&string2, "hello", 0);
+
+    size_t pos = 0;
+    ASSERT_EQ(my_str_find_pos(&string1, &string2, 0, &pos), 0);
+    ASSERT_EQ(pos, 0);
+    ASSERT_EQ(my_str_find_pos(&string1, &string2, 1, &pos), 0);
+    ASSERT_EQ(pos, 14);
+
+    // position is not changed if nothing is found
+    ASSERT_EQ(my_str_find_pos(&string1, &string2, 15, &pos), NOT_FOUND_CODE);
+    ASSERT_EQ(my_str_find_pos(&string1, &string2, SIZE_MAX, &pos), NOT_FOUND_CODE);
+    ASSERT_EQ(my_str_find_pos(&string2, &string1, 0, &pos), NOT_FOUND_CODE);
+    my_str_clear(&string2);
+    ASSERT_EQ(my_str_find_pos(&string1, &string2, 0, &pos), NOT_FOUND_CODE);
+    ASSERT_EQ(pos, 14);
+
+    ASSERT_EQ(my_str_find_pos(&string1, &string2, 0, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_find_pos(nullptr, &string2, 0, &pos), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_find_pos(&string1, nullptr, 0, &pos), NULL_PTR_ERR);
+}
+
+TEST_F(ClassDeclaration, my_str_find_blocks) {
+    // matches in every position of the vector blocks and right before the end
+    for (size_t size = 1; size < 80; size++) {
+        std::string text(size, 'a');
+        for (size_t pos = 0; pos < size; pos++) {
+            text[pos] = 'b';
+            my_str_from_cstr(&string1, text.c_str(), 0);
+            ASSERT_EQ(my_str_find_c(&string1, 'b', 0), static_cast<int>(pos));
+            ASSERT_EQ(my_str_find_c(&string1, 'b', pos + 1), NOT_FOUND_CODE);
+            my_str_from_cstr(&string2, "ab", 0);
+            ASSERT_EQ(my_str_find(&string1, &string2, 0), pos ? pos - 1 : (size_t) NOT_FOUND_CODE);
+            text[pos] = 'a';
+        }
+    }
+
+    // bytes after the content are never matched
+    my_str_from_cstr(&string1, "abcabc", 0);
+    my_str_popback(&string1);
+    ASSERT_EQ(my_str_find_c(&string1, 'c', 3), NOT_FOUND_CODE);
+    my_str_from_cstr(&string2, "bc", 0);
+    ASSERT_EQ(my_str_find(&string1, &string2, 2), (size_t) NOT_FOUND_CODE);
+}
+
+TEST_F(ClassDeclaration, my_str_hash) {
+    my_str_from_cstr(&string1, "hello, world", 20);
+    my_str_from_cstr(&string2, "hello, world", 40);
+
+    // the same content gives the same hash, whatever holds it
+    ASSERT_EQ(my_str_hash(&string1, 0), my_str_hash(&string2, 0));
+    ASSERT_EQ(my_str_hash(&string1, 7), my_str_hash_view(my_str_view_cstr("hello, world"), 7));
+    ASSERT_EQ(my_str_hash(&string1, 7), my_str_hash_bytes("hello, world", 12, 7));
+
+    // seed changes the hash
+    ASSERT_NE(my_str_hash(&string1, 0), my_str_hash(&string1, 1));
+
+    // all prefixes of a long string (every branch of the hash) are different
+    std::string long_string;
+    for (size_t i = 0; i < 300; i++)
+        long_string.push_back(static_cast<char>('a' + i % 26));
+    std::set<uint64_t> hashes;
+    for (size_t i = 0; i <= long_string.size(); i++)
+        hashes.insert(my_str_hash_bytes(long_string.data(), i, 0));
+    ASSERT_EQ(hashes.size(), long_string.size() + 1);
+
+    // one changed byte changes the hash
+    for (size_t i = 0; i < 100; i++) {
+        std::string changed = long_string.substr(0, 100);
+        changed[i] = '#';
+        ASSERT_NE(my_str_hash_bytes(changed.data(), 100, 0), my_str_hash_bytes(long_string.data(), 100, 0));
+    }
+
+    // NULL is an empty string
+    ASSERT_EQ(my_str_hash(nullptr, 3), my_str_hash(&string3, 3));
+    ASSERT_EQ(my_str_hash_bytes(nullptr, 10, 3), my_str_hash(&string3, 3));
+}
+
+TEST_F(ClassDeclaration, my_str_hash_cached) {
+    my_str_from_cstr(&string1, "hello, world", 20);
+
+    // hash is remembered
+    ASSERT_EQ(string1.hash_m, 0);
+    ASSERT_EQ(my_str_hash_cached(&string1), my_str_hash(&string1, 0));
+    ASSERT_EQ(string1.hash_m, my_str_hash(&string1, 0));
+
+    // changes of the string forget it
+    my_str_append_c(&string1, '!');
+    ASSERT_EQ(string1.hash_m, 0);
+    ASSERT_EQ(my_str_hash_cached(&string1), my_str_hash_bytes("hello, world!", 13, 0));
+    my_str_putc(&string1, 0, 'j');
+    ASSERT_EQ(string1.hash_m, 0);
+    my_str_hash_cached(&string1);
+    my_str_popback(&string1);
+    ASSERT_EQ(string1.hash_m, 0);
+    my_str_hash_cached(&string1);
+    my_str_erase(&string1, 0, 1);
+    ASSERT_EQ(string1.hash_m, 0);
+    my_str_hash_cached(&string1);
+    my_str_insert_cstr(&string1, "h", 0);
+    ASSERT_EQ(string1.hash_m, 0);
+
+    // reserve does not change content, so hash is kept
+    my_str_hash_cached(&string1);
+    my_str_reserve(&string1, 100);
+    ASSERT_EQ(string1.hash_m, my_str_hash_bytes("hello, world", 12, 0));
+
+    // direct changes require invalidation
+    string1.data[0] = 'j';
+    ASSERT_EQ(my_str_hash_invalidate(&string1), 0);
+    ASSERT_EQ(my_str_hash_cached(&string1), my_str_hash_bytes("jello, world", 12, 0));
+
+    // NULL string
+    ASSERT_EQ(my_str_hash_cached(nullptr), my_str_hash(&string3, 0));
+    ASSERT_EQ(my_str_hash_invalidate(nullptr), NULL_PTR_ERR);
+}
+
+TEST_F(ClassDeclaration, my_str_equal) {
+    my_str_from_cstr(&string1, "hello, world", 20);
+    my_str_from_cstr(&string2, "hello, world", 40);
+
+    // equal strings, with and without remembered hashes
+    ASSERT_EQ(my_str_equal(&string1, &string2), 1);
+    my_str_hash_cached(&string1);
+    my_str_hash_cached(&string2);
+    ASSERT_EQ(my_str_equal(&string1, &string2), 1);
+
+    // different strings of the same size
+    my_str_from_cstr(&string2, "hello, wordl", 40);
+    my_str_hash_cached(&string2);
+    ASSERT_EQ(my_str_equal(&string1, &string2), 0);
+
+    // different sizes
+    ASSERT_EQ(my_str_equal(&string1, &string3), 0);
+    my_str_clear(&string1);
+    ASSERT_EQ(my_str_equal(&string1, &string3), 1);
+
+    // one of strings is NULL
+    ASSERT_EQ(my_str_equal(nullptr, &string1), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_equal(&string1, nullptr), NULL_PTR_ERR);
+}
+
 TEST_F(ClassDeclaration, my_str_cmp) {
     // equal size normal strings
     my_str_from_cstr(&string1, "hello", 20);
@@ -1081,6 +1453,25 @@ TEST_F(ClassDeclaration, my_str_find_c) {
     ASSERT_EQ(my_str_find_c(nullptr, 'd', 10), static_cast<size_t>(NULL_PTR_ERR));
 }
 
+TEST_F(ClassDeclaration, my_str_find_c_pos) {
+    my_str_from_cstr(&string1, "hello, world", 20);
+
+    size_t pos = 0;
+    ASSERT_EQ(my_str_find_c_pos(&string1, 'l', 4, &pos), 0);
+    ASSERT_EQ(pos, 10);
+    ASSERT_EQ(my_str_find_c_pos(&string1, 'l', 11, &pos), NOT_FOUND_CODE);
+    ASSERT_EQ(my_str_find_c_pos(&string1, 'l', SIZE_MAX, &pos), NOT_FOUND_CODE);
+
+    // zero byte is an ordinary symbol, and the terminator is not a part of the string
+    ASSERT_EQ(my_str_find_c_pos(&string1, '\0', 0, &pos), NOT_FOUND_CODE);
+    my_str_resize(&string1, 15, '\0');
+    ASSERT_EQ(my_str_find_c_pos(&string1, '\0', 0, &pos), 0);
+    ASSERT_EQ(pos, 12);
+
+    ASSERT_EQ(my_str_find_c_pos(nullptr, 'l', 0, &pos), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_find_c_pos(&string1, 'l', 0, nullptr), NULL_PTR_ERR);
+}
+
 static inline int equal_l(int symbol) {
     return symbol == 'l';
 }
@@ -1156,6 +1547,21 @@ static inline void test_write_file(const char *c_str_path, std::string &&content
     } else throw std::runtime_error("Unable to write to file");
 }
 
+TEST_F(ClassDeclaration, my_str_find_if_pos) {
+    my_str_from_cstr(&string1, "123987456", 20);
+
+    size_t pos = 0;
+    ASSERT_EQ(my_str_find_if_pos(&string1, 4, gt_5, &pos), 0);
+    ASSERT_EQ(pos, 4);
+    ASSERT_EQ(my_str_find_if_pos(&string1, 0, equal_s, &pos), NOT_FOUND_CODE);
+    ASSERT_EQ(my_str_find_if_pos(&string1, SIZE_MAX, true_predicate, &pos), NOT_FOUND_CODE);
+    ASSERT_EQ(pos, 4);
+
+    ASSERT_EQ(my_str_find_if_pos(nullptr, 0, gt_5, &pos), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_find_if_pos(&string1, 0, nullptr, &pos), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_find_if_pos(&string1, 0, gt_5, nullptr), NULL_PTR_ERR);
+}
+
 TEST_F(ClassDeclaration, my_str_write_file) {
     my_str_from_cstr(&string1, "hello, \nworld", 20);
     char path_to_wfile[500];
@@ -1309,6 +1715,31 @@ TEST_F(ClassDeclaration, my_str_read) {
     if (nstdin)
         fclose(nstdin);
 
+    // stdin without any data
+    file = fopen(path_to_rfile, "w");
+    if (file)
+        fclose(file);
+
+    nstdin = freopen(path_to_rfile, "r", stdin);
+    ASSERT_EQ(my_str_read(&string2), 0);
+    ASSERT_EQ(my_str_size(&string2), 0);
+    if (nstdin)
+        fclose(nstdin);
+
+    // bytes already buffered by stdio are not lost
+    my_str_from_cstr(&string1, "hello\nworld\n", 20);
+    file = fopen(path_to_rfile, "w");
+    my_str_write_file(&string1, file);
+    if (file)
+        fclose(file);
+
+    nstdin = freopen(path_to_rfile, "r", stdin);
+    ASSERT_EQ(getchar(), 'h');
+    ASSERT_EQ(my_str_read(&string2), 0);
+    ASSERT_STREQ(my_str_get_cstr(&string2), "ello\nworld");
+    if (nstdin)
+        fclose(nstdin);
+
     // read from empty stdin
     my_str_from_cstr(&string1, "\n", 20);
     file = fopen(path_to_rfile, "w");
@@ -1327,6 +1758,81 @@ TEST_F(ClassDeclaration, my_str_read) {
     ASSERT_EQ(my_str_read(NULL), NULL_PTR_ERR);
 }
 
+TEST_F(ClassDeclaration, my_str_read_fd) {
+    // data larger than one read and than the initial buffer
+    std::string content(3 * READ_CHUNK_SIZE + 17, 'a');
+    for (size_t i = 0; i < content.size(); i++)
+        content[i] = static_cast<char>('a' + i % 26);
+
+    unique_file_ptr file{tmpfile(), fclose};
+    ASSERT_TRUE(file);
+    ASSERT_EQ(fwrite(content.data(), 1, content.size(), file.get()), content.size());
+    fflush(file.get());
+
+    // regular file, size is taken from the file
+    ASSERT_EQ(lseek(fileno(file.get()), 0, SEEK_SET), 0);
+    ASSERT_EQ(my_str_read_fd(&string1, fileno(file.get()), 0), 0);
+    ASSERT_EQ(my_str_size(&string1), content.size());
+    ASSERT_EQ(std::string(string1.data, string1.size_m), content);
+
+    // too small size hint, buffer grows
+    ASSERT_EQ(lseek(fileno(file.get()), 10, SEEK_SET), 10);
+    ASSERT_EQ(my_str_read_fd(&string2, fileno(file.get()), 1), 0);
+    ASSERT_EQ(std::string(string2.data, string2.size_m), content.substr(10));
+
+    // pipe
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "hello, world", 12), 12);
+    close(fds[1]);
+    ASSERT_EQ(my_str_read_fd(&string3, fds[0], 0), 0);
+    ASSERT_STREQ(my_str_get_cstr(&string3), "hello, world");
+
+    // empty pipe
+    ASSERT_EQ(pipe(fds), 0);
+    close(fds[1]);
+    ASSERT_EQ(my_str_read_fd(&string3, fds[0], 0), 0);
+    ASSERT_STREQ(my_str_get_cstr(&string3), "");
+    close(fds[0]);
+
+    // bad arguments
+    ASSERT_EQ(my_str_read_fd(&string1, -1, 0), IO_READ_ERR);
+    ASSERT_EQ(my_str_read_fd(nullptr, 0, 0), NULL_PTR_ERR);
+}
+
+static int collect_chunks(const char *chunk, size_t size, void *arg) {
+    static_cast<std::string *>(arg)->append(chunk, size);
+    return 0;
+}
+
+static int stop_on_first_chunk(const char *, size_t, void *) {
+    return 1;
+}
+
+TEST_F(ClassDeclaration, my_str_read_fd_chunks) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "hello, world", 12), 12);
+    close(fds[1]);
+
+    // every chunk is handed over, small chunk size
+    std::string collected;
+    ASSERT_EQ(my_str_read_fd_chunks(fds[0], 5, collect_chunks, &collected), 0);
+    ASSERT_EQ(collected, "hello, world");
+    close(fds[0]);
+
+    // callback stops reading
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "hello", 5), 5);
+    ASSERT_EQ(my_str_read_fd_chunks(fds[0], 0, stop_on_first_chunk, nullptr), 1);
+    close(fds[0]);
+    close(fds[1]);
+
+    // bad arguments
+    ASSERT_EQ(my_str_read_fd_chunks(-1, 0, collect_chunks, &collected), IO_READ_ERR);
+    ASSERT_EQ(my_str_read_fd_chunks(0, 0, nullptr, nullptr), NULL_PTR_ERR);
+}
+
 TEST_F(ClassDeclaration, my_str_write) {
     testing::internal::CaptureStdout();
 
@@ -1350,6 +1856,74 @@ TEST_F(ClassDeclaration, my_str_write) {
     // string is null
     ASSERT_EQ(my_str_write(NULL), NULL_PTR_ERR);
 }
+
+TEST_F(ClassDeclaration, my_str_write_fd) {
+    my_str_from_cstr(&string1, "hello, \nworld", 20);
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    // normal write to the pipe
+    ASSERT_EQ(my_str_write_fd(&string1, fds[1]), 0);
+    char buf[32] = {0};
+    ASSERT_EQ(read(fds[0], buf, sizeof(buf) - 1), static_cast<ssize_t>(my_str_size(&string1)));
+    ASSERT_STREQ(buf, "hello, \nworld");
+
+    // empty string writes nothing
+    ASSERT_EQ(my_str_write_fd(&string2, fds[1]), 0);
+
+    // bad descriptor
+    ASSERT_EQ(my_str_write_fd(&string1, -1), IO_WRITE_ERR);
+    close(fds[0]);
+    close(fds[1]);
+
+    // string is NULL
+    ASSERT_EQ(my_str_write_fd(nullptr, 1), NULL_PTR_ERR);
+}
+
+TEST_F(ClassDeclaration, my_str_transfer_file) {
+    unique_file_ptr src{tmpfile(), fclose};
+    unique_file_ptr dst{tmpfile(), fclose};
+    ASSERT_TRUE(src && dst);
+
+    my_str_from_cstr(&string1, "hello, world! this is transferred", 40);
+    ASSERT_EQ(my_str_write_file(&string1, src.get()), 0);
+    rewind(src.get());
+
+    // part of file, stream position moves after transferred bytes
+    size_t transferred = 0;
+    ASSERT_EQ(my_str_transfer_file(src.get(), fileno(dst.get()), 5, &transferred), 0);
+    ASSERT_EQ(transferred, 5);
+    ASSERT_EQ(ftell(src.get()), 5);
+
+    // data that was already buffered by stdio is not lost
+    ASSERT_EQ(fgetc(src.get()), ',');
+
+    // rest of file
+    ASSERT_EQ(my_str_transfer_file(src.get(), fileno(dst.get()), SIZE_MAX, &transferred), 0);
+    ASSERT_EQ(transferred, my_str_size(&string1) - 6);
+    ASSERT_EQ(my_str_transfer_file(src.get(), fileno(dst.get()), SIZE_MAX, &transferred), 0);
+    ASSERT_EQ(transferred, 0);
+
+    rewind(dst.get());
+    ASSERT_EQ(my_str_read_file(&string2, dst.get()), 0);
+    ASSERT_STREQ(my_str_get_cstr(&string2), "hello world! this is transferred");
+
+    // transfer into the pipe
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    rewind(src.get());
+    ASSERT_EQ(my_str_transfer_file(src.get(), fds[1], 5, nullptr), 0);
+    char buf[8] = {0};
+    ASSERT_EQ(read(fds[0], buf, sizeof(buf) - 1), 5);
+    ASSERT_STREQ(buf, "hello");
+    close(fds[0]);
+    close(fds[1]);
+
+    // bad arguments
+    ASSERT_EQ(my_str_transfer_file(src.get(), -1, 5, nullptr), IO_WRITE_ERR);
+    ASSERT_EQ(my_str_transfer_file(nullptr, 1, 5, nullptr), NULL_PTR_ERR);
+}
+
 // TODO: check next tests!
 //TEST_F(ClassDeclaration, my_str_read_file) {
 //    try {
@@ -0,0 +1,124 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "c_string_vec.h"
+}
+
+namespace {
+    class VecDeclaration : public testing::Test {
+    protected:
+        my_str_vec_t vec{};
+
+        void SetUp() override {
+            my_str_vec_create(&vec, 0, 0);
+        }
+
+        void TearDown() override {
+            my_str_vec_free(&vec);
+        }
+
+        std::string get(size_t index) const {
+            my_str_view_t str;
+            EXPECT_EQ(my_str_vec_get(&vec, index, &str), 0);
+            return std::string(str.data, str.size_m);
+        }
+    };
+}
+
+TEST_F(VecDeclaration, my_str_vec_append) {
+    std::vector<std::string> words;
+    for (size_t i = 0; i < 1000; i++) {
+        words.push_back(std::string(i % 7, static_cast<char>('a' + i % 26)));
+        ASSERT_EQ(my_str_vec_append(&vec, my_str_view_t{words.back().data(), words.back().size()}), 0);
+    }
+
+    my_str_t str;
+    my_str_create(&str, 0);
+    my_str_from_cstr(&str, "from my_str", 0);
+    ASSERT_EQ(my_str_vec_append_str(&vec, &str), 0);
+    words.push_back("from my_str");
+    my_str_free(&str);
+
+    ASSERT_EQ(my_str_vec_size(&vec), words.size());
+    for (size_t i = 0; i < words.size(); i++)
+        ASSERT_EQ(get(i), words[i]);
+
+    // all strings are kept in a single blob
+    ASSERT_EQ(vec.blob.size_m, vec.offsets[vec.size_m]);
+
+    my_str_view_t view;
+    ASSERT_EQ(my_str_vec_get(&vec, words.size(), &view), RANGE_ERR);
+    ASSERT_EQ(my_str_vec_get(&vec, 0, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_vec_append(nullptr, my_str_view_cstr("a")), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_vec_append_str(&vec, nullptr), NULL_PTR_ERR);
+    ASSERT_EQ(my_str_vec_size(nullptr), 0);
+
+    my_str_vec_clear(&vec);
+    ASSERT_EQ(my_str_vec_size(&vec), 0);
+    ASSERT_EQ(my_str_vec_append(&vec, my_str_view_cstr("again")), 0);
+    ASSERT_EQ(get(0), "again");
+}
+
+TEST_F(VecDeclaration, my_str_vec_from_split) {
+    my_str_vec_append(&vec, my_str_view_cstr("old"));
+
+    ASSERT_EQ(my_str_vec_from_split(&vec, my_str_view_cstr(",one,,two,three,"), ','), 0);
+    std::vector<std::string> expected{"", "one", "", "two", "three", ""};
+    ASSERT_EQ(my_str_vec_size(&vec), expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+        ASSERT_EQ(get(i), expected[i]);
+
+    ASSERT_EQ(my_str_vec_from_split(&vec, my_str_view_cstr("no delimiters"), ','), 0);
+    ASSERT_EQ(my_str_vec_size(&vec), 1);
+    ASSERT_EQ(get(0), "no delimiters");
+
+    ASSERT_EQ(my_str_vec_from_split(&vec, my_str_view_cstr(""), ','), 0);
+    ASSERT_EQ(my_str_vec_size(&vec), 1);
+    ASSERT_EQ(get(0), "");
+
+    ASSERT_EQ(my_str_vec_from_split(nullptr, my_str_view_cstr("a"), ','), NULL_PTR_ERR);
+}
+
+TEST_F(VecDeclaration, my_str_vec_find_all) {
+    // occurrences crossing the border of two strings must not be found
+    my_str_vec_from_split(&vec, my_str_view_cstr("abc|cab|xyz||ababc|ab|c"), '|');
+    std::vector<size_t> positions(my_str_vec_size(&vec));
+
+    ASSERT_EQ(my_str_vec_find_all(&vec, my_str_view_cstr("abc"), positions.data()), 0);
+    std::vector<size_t> expected{0, (size_t) NOT_FOUND_CODE, (size_t) NOT_FOUND_CODE,
+                                 (size_t) NOT_FOUND_CODE, 2, (size_t) NOT_FOUND_CODE, (size_t) NOT_FOUND_CODE};
+    ASSERT_EQ(positions, expected);
+
+    ASSERT_EQ(my_str_vec_find_all(&vec, my_str_view_cstr("ab"), positions.data()), 0);
+    expected = {0, 1, (size_t) NOT_FOUND_CODE, (size_t) NOT_FOUND_CODE, 0, 0, (size_t) NOT_FOUND_CODE};
+    ASSERT_EQ(positions, expected);
+
+    // compared with searching every string alone
+    for (const char* pattern: {"c", "b", "z", "ababc", "", "abcabc"}) {
+        ASSERT_EQ(my_str_vec_find_all(&vec, my_str_view_cstr(pattern), positions.data()), 0);
+        for (size_t i = 0; i < positions.size(); i++) {
+            size_t pos = *pattern ? get(i).find(pattern) : std::string::npos;
+            ASSERT_EQ(positions[i], pos == std::string::npos ? (size_t) NOT_FOUND_CODE : pos) << pattern << i;
+        }
+    }
+
+    ASSERT_EQ(my_str_vec_find_all(&vec, my_str_view_cstr("a"), nullptr), NULL_PTR_ERR);
+}
+
+TEST_F(VecDeclaration, my_str_vec_cmp_all) {
+    my_str_vec_from_split(&vec, my_str_view_cstr("b a ba bb  \xff"), ' ');
+    std::vector<int> results(my_str_vec_size(&vec));
+
+    ASSERT_EQ(my_str_vec_cmp_all(&vec, my_str_view_cstr("b"), results.data()), 0);
+    ASSERT_EQ(results, (std::vector<int>{0, -1, 1, 1, -1, 1}));
+
+    ASSERT_EQ(my_str_vec_cmp_all(&vec, my_str_view_cstr(""), results.data()), 0);
+    ASSERT_EQ(results, (std::vector<int>{1, 1, 1, 1, 0, 1}));
+
+    ASSERT_EQ(my_str_vec_cmp_all(&vec, my_str_view_cstr("b"), nullptr), NULL_PTR_ERR);
+}